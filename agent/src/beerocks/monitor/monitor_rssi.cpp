@@ -13,6 +13,7 @@
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_monitor.h>
+#include <tlvf/ieee_1905_1/tlvEndOfMessage.h>
 
 using namespace beerocks;
 using namespace net;
@@ -219,23 +220,17 @@ void monitor_rssi::process()
                      sta_stats.rx_rssi_curr <= conf_rx_rssi_notification_threshold_dbm)) {
                     sta_stats.rx_rssi_prev = sta_stats.rx_rssi_curr;
 
-                    auto notification = message_com::create_vs_message<
-                        beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION>(
-                        cmdu_tx);
-                    if (notification == nullptr) {
-                        LOG(ERROR) << "Failed building "
-                                      "ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUES message!";
-                        break;
-                    }
-
-                    notification->params().result.mac = network_utils::mac_from_string(sta_mac);
-                    notification->params().rx_rssi    = sta_stats.rx_rssi_curr;
-                    notification->params().rx_snr     = sta_stats.rx_snr_curr;
-                    notification->params().rx_packets = 100; //dummy value
-                    notification->params().rx_phy_rate_100kb = sta_stats.rx_phy_rate_100kb_min;
-                    notification->params().tx_phy_rate_100kb = sta_stats.tx_phy_rate_100kb_min;
-                    notification->params().vap_id            = sta_vap_id;
-                    message_com::send_cmdu(slave_socket, cmdu_tx);
+                    // notifications are coalesced and sent once per poll cycle
+                    beerocks_message::sNodeRssiMeasurement params = {};
+                    params.struct_init();
+                    params.result.mac        = network_utils::mac_from_string(sta_mac);
+                    params.rx_rssi           = sta_stats.rx_rssi_curr;
+                    params.rx_snr            = sta_stats.rx_snr_curr;
+                    params.rx_packets        = 100; //dummy value
+                    params.rx_phy_rate_100kb = sta_stats.rx_phy_rate_100kb_min;
+                    params.tx_phy_rate_100kb = sta_stats.tx_phy_rate_100kb_min;
+                    params.vap_id            = sta_vap_id;
+                    m_rx_rssi_notifications.push_back(params);
                     LOG(DEBUG) << "state IDLE, DELTA notification MAC: " << sta_mac
                                << " RX RSSI: " << int(sta_stats.rx_rssi_curr)
                                << " delta_val=" << int(delta_val);
@@ -346,6 +341,62 @@ void monitor_rssi::process()
             monitor_idle_station(sta_mac, sta_node);
         }
     }
+
+    send_rx_rssi_notifications();
+}
+
+void monitor_rssi::send_rx_rssi_notifications()
+{
+    std::shared_ptr<
+        beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>
+        notification;
+    // keep room for the End Of Message TLV added by finalize()
+    const size_t tlvEndSize = ieee1905_1::tlvEndOfMessage::get_initial_size();
+
+    auto send_notification = [&]() {
+        if (!message_com::send_cmdu(slave_socket, cmdu_tx)) {
+            LOG(ERROR) << "Failed sending RX RSSI notification of "
+                       << int(notification->params_size()) << " station(s)";
+        }
+        notification = nullptr;
+    };
+
+    auto it = m_rx_rssi_notifications.begin();
+    while (it != m_rx_rssi_notifications.end()) {
+        if (!notification) {
+            notification = message_com::create_vs_message<
+                beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>(
+                cmdu_tx);
+            if (notification == nullptr) {
+                LOG(ERROR) << "Failed building "
+                              "cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION "
+                              "message!";
+                break;
+            }
+        }
+
+        // send the current message once it can't hold another station and start a new one
+        if (notification->params_size() == UINT8_MAX ||
+            notification->getBuffRemainingBytes() < sizeof(*it) + tlvEndSize ||
+            !notification->alloc_params()) {
+            if (!notification->params_size()) {
+                LOG(ERROR) << "Failed buffer allocation, dropping "
+                           << std::distance(it, m_rx_rssi_notifications.end())
+                           << " RX RSSI notification(s)";
+                notification = nullptr;
+                break;
+            }
+            send_notification();
+            continue;
+        }
+        std::get<1>(notification->params(notification->params_size() - 1)) = *it;
+        ++it;
+    }
+
+    if (notification) {
+        send_notification();
+    }
+    m_rx_rssi_notifications.clear();
 }
 
 void monitor_rssi::send_rssi_measurement_response(std::string &sta_mac, monitor_sta_node *sta_node)
@@ -14,8 +14,11 @@
 #include <beerocks/bcl/beerocks_message_structs.h>
 #include <beerocks/bcl/network/socket.h>
 
+#include <beerocks/tlvf/beerocks_message_common.h>
 #include <tlvf/CmduMessageTx.h>
 
+#include <vector>
+
 const unsigned DEFAULT_IDLE_UNIT_TX_THRESHOLD = 50000;
 const unsigned DEFAULT_IDLE_UNIT_RX_THRESHOLD = 50000;
 const unsigned DEFAULT_IDLE_UNIT_TIME_MS      = 1000;
@@ -42,6 +45,7 @@ public:
 private:
     void send_rssi_measurement_response(std::string &sta_mac, monitor_sta_node *sta_node);
     void monitor_idle_station(std::string &sta_mac, monitor_sta_node *sta_node);
+    void send_rx_rssi_notifications();
 
     monitor_db *mon_db = nullptr;
     Socket *slave_socket;
@@ -53,6 +57,9 @@ private:
     unsigned m_idle_unit_time_ms;
 
     ieee1905_1::CmduMessageTx &cmdu_tx;
+
+    // rx rssi notifications of the current poll cycle
+    std::vector<beerocks_message::sNodeRssiMeasurement> m_rx_rssi_notifications;
 };
 
 } //namespace son
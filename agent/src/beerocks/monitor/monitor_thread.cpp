@@ -455,6 +455,8 @@ bool monitor_thread::update_sta_stats()
     auto poll_cnt  = mon_db.get_poll_cnt();
     auto poll_last = mon_db.is_last_poll();
 
+    // A station which fails to update is skipped, the others are still updated
+    bool ret = true;
     for (auto it = mon_db.sta_begin(); it != mon_db.sta_end(); ++it) {
 
         auto sta_mac  = it->first;
@@ -465,14 +467,21 @@ bool monitor_thread::update_sta_stats()
             continue;
         }
 
-        auto vap_node   = mon_db.vap_get_by_id(sta_node->get_vap_id());
+        auto vap_node = mon_db.vap_get_by_id(sta_node->get_vap_id());
+        if (!vap_node) {
+            LOG(ERROR) << "Invalid vap_id " << int(sta_node->get_vap_id()) << " of STA " << sta_mac;
+            ret = false;
+            continue;
+        }
+
         auto &sta_stats = sta_node->get_stats();
 
         // Update the stats
         if (!mon_wlan_hal->update_stations_stats(vap_node->get_iface(), sta_mac,
                                                  sta_stats.hal_stats)) {
             LOG(ERROR) << "Failed updating STA (" << sta_mac << ") statistics!";
-            return false;
+            ret = false;
+            continue;
         }
 
         // Reset STA poll data
@@ -543,7 +552,7 @@ bool monitor_thread::update_sta_stats()
         sta_stats.last_update_time = now;
     }
 
-    return true;
+    return ret;
 }
 
 bool monitor_thread::update_ap_stats()
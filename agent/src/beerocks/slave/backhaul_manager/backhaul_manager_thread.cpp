@@ -568,8 +568,8 @@ bool main_thread::backhaul_fsm_main(bool &skip_select)
             m_scPlatform.reset();
         }
 
-        m_scPlatform = std::make_shared<SocketClient>(
-            SocketClient(beerocks_temp_path + std::string(BEEROCKS_PLAT_MGR_UDS)));
+        m_scPlatform =
+            std::make_shared<SocketClient>(beerocks_temp_path + std::string(BEEROCKS_PLAT_MGR_UDS));
         std::string err = m_scPlatform->getError();
         if (!err.empty()) {
             m_scPlatform.reset();
@@ -925,7 +925,7 @@ bool main_thread::backhaul_fsm_wireless(bool &skip_select)
                 // Events
                 int ext_events_fd = soc->sta_wlan_hal->get_ext_events_fd();
                 int int_events_fd = soc->sta_wlan_hal->get_int_events_fd();
-                if (ext_events_fd >= 0 && int_events_fd) {
+                if (ext_events_fd >= 0 && int_events_fd >= 0) {
                     soc->sta_hal_ext_events = new Socket(ext_events_fd);
                     add_socket(soc->sta_hal_ext_events);
 
@@ -1574,7 +1574,7 @@ bool main_thread::handle_1905_autoconfiguration_response(ieee1905_1::CmduMessage
         return true;
     }
 
-    auto tlvSupportedRole = cmdu_rx.addClass<ieee1905_1::tlvSupportedRole>();
+    auto tlvSupportedRole = cmdu_rx.getTlv<ieee1905_1::tlvSupportedRole>();
     if (tlvSupportedRole) {
         LOG(DEBUG) << "tlvSupportedRole->value()=" << int(tlvSupportedRole->value());
         if (tlvSupportedRole->value() != ieee1905_1::tlvSupportedRole::REGISTRAR) {
@@ -1589,7 +1589,7 @@ bool main_thread::handle_1905_autoconfiguration_response(ieee1905_1::CmduMessage
     controller_bridge_mac = src_mac;
     LOG(INFO) << "update controller_bridge_mac=" << controller_bridge_mac;
 
-    auto tlvSupportedFreqBand = cmdu_rx.addClass<ieee1905_1::tlvSupportedFreqBand>();
+    auto tlvSupportedFreqBand = cmdu_rx.getTlv<ieee1905_1::tlvSupportedFreqBand>();
     if (tlvSupportedFreqBand) {
         LOG(DEBUG) << "tlvSupportedFreqBand->value()=" << int(tlvSupportedFreqBand->value());
 
@@ -1645,7 +1645,7 @@ bool main_thread::handle_1905_autoconfiguration_response(ieee1905_1::CmduMessage
         return true;
     }
 
-    auto tlvSupportedService = cmdu_rx.addClass<wfa_map::tlvSupportedService>();
+    auto tlvSupportedService = cmdu_rx.getTlv<wfa_map::tlvSupportedService>();
     if (tlvSupportedService) {
         bool controllerFound = false;
         for (int i = 0; i < tlvSupportedService->supported_service_list_length(); i++) {
@@ -3009,6 +3009,37 @@ bool slave_thread::handle_cmdu_monitor_message(
         send_cmdu_to_controller(cmdu_tx);
         break;
     }
+    case beerocks_message::ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION: {
+        auto notification_in = cmdu_rx.addClass<
+            beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>();
+        if (notification_in == nullptr) {
+            LOG(ERROR)
+                << "addClass cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION failed";
+            return false;
+        }
+
+        auto notification_out = message_com::create_vs_message<
+            beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>(
+            cmdu_tx);
+        if (notification_out == nullptr) {
+            LOG(ERROR) << "Failed building message!";
+            return false;
+        }
+
+        auto params_size = notification_in->params_size();
+        if (params_size > 0) {
+            if (!notification_out->alloc_params(params_size)) {
+                LOG(ERROR) << "Failed buffer allocation to size=" << int(params_size);
+                break;
+            }
+            auto params_tuple_in  = notification_in->params(0);
+            auto params_tuple_out = notification_out->params(0);
+            std::copy_n(&std::get<1>(params_tuple_in), params_size,
+                        &std::get<1>(params_tuple_out));
+        }
+        send_cmdu_to_controller(cmdu_tx);
+        break;
+    }
     case beerocks_message::ACTION_MONITOR_STEERING_EVENT_CLIENT_ACTIVITY_NOTIFICATION: {
         auto notification_in = cmdu_rx.addClass<
             beerocks_message::cACTION_MONITOR_STEERING_EVENT_CLIENT_ACTIVITY_NOTIFICATION>();
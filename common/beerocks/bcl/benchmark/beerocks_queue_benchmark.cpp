@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+// Compares the throughput of the mutex based thread_safe_queue with the lock-free queues.
+// usage: beerocks_queue_benchmark [items per producer]
+
+#include <beerocks/bcl/beerocks_lockfree_queue.h>
+#include <beerocks/bcl/beerocks_thread_safe_queue.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace beerocks;
+
+// HAL events are delivered as shared pointers
+typedef std::shared_ptr<size_t> item_t;
+
+static const size_t kQueueSize = 1024;
+
+template <typename Q> static bool run(const std::string &name, int producers, size_t items)
+{
+    Q queue;
+    size_t total = producers * items;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&queue, items]() {
+            for (size_t i = 1; i <= items; i++) {
+                queue.push(std::make_shared<size_t>(i));
+            }
+        });
+    }
+
+    size_t received = 0, sum = 0;
+    while (received < total) {
+        auto item = queue.pop();
+        if (item) {
+            sum += *item;
+            received++;
+        }
+    }
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+
+    bool ok = (sum == producers * (items * (items + 1) / 2));
+    std::cout << name << " producers=" << producers << ": " << usec << " usec, "
+              << (usec * 1000.0 / total) << " nsec/item" << (ok ? "" : " - MISMATCH!")
+              << std::endl;
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t items = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    bool ok      = true;
+
+    ok &= run<thread_safe_queue<item_t>>("thread_safe_queue", 1, items);
+    ok &= run<spsc_queue<item_t, kQueueSize>>("spsc_queue       ", 1, items);
+    ok &= run<mpsc_queue<item_t, kQueueSize>>("mpsc_queue       ", 1, items);
+
+    ok &= run<thread_safe_queue<item_t>>("thread_safe_queue", 4, items);
+    ok &= run<mpsc_queue<item_t, kQueueSize>>("mpsc_queue       ", 4, items);
+
+    return ok ? 0 : 1;
+}
@@ -25,6 +25,7 @@ public:
         std::string syslog_levels;
         std::string global_size;
         std::string syslog_enabled;
+        std::string async_enabled;
         std::string netlog_host;
         std::string netlog_port;
     };
@@ -59,6 +59,9 @@ enum eMessageConsts {
     MESSAGE_VERSION       = 6,
     MESSAGE_MAGIC         = 0x55CDABEF,
     MESSAGE_BUFFER_LENGTH = 4096,
+    // Maximal length of a local (UDS / local bus) message, including the UDS header.
+    // Messages longer than MESSAGE_BUFFER_LENGTH are built and received in pooled buffers.
+    MESSAGE_BUFFER_LENGTH_MAX = 65536,
 };
 } //namespace message
 
@@ -0,0 +1,286 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BEEROCKS_LOCKFREE_QUEUE_H_
+#define _BEEROCKS_LOCKFREE_QUEUE_H_
+
+#include <atomic>
+#include <errno.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+namespace beerocks {
+
+/**
+ * Wakeup of a lock-free queue consumer.
+ *
+ * The eventfd is readable while the queue is not empty, so the queue can be added to a
+ * select/epoll set using get_event_fd(). It is created in semaphore mode, every read consumes a
+ * single signal.
+ */
+class queue_event_fd {
+public:
+    queue_event_fd() : m_fd(eventfd(0, EFD_SEMAPHORE | EFD_NONBLOCK | EFD_CLOEXEC)) {}
+    ~queue_event_fd()
+    {
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+    queue_event_fd(const queue_event_fd &) = delete;
+    queue_event_fd &operator=(const queue_event_fd &) = delete;
+
+    // -1 if the eventfd couldn't be created, the queue is then unusable
+    int fd() const { return m_fd; }
+
+    void signal()
+    {
+        uint64_t counter = 1;
+        while (write(m_fd, &counter, sizeof(counter)) < 0 && errno == EINTR) {
+        }
+    }
+
+    // wait until signaled, return false on timeout (0 waits forever)
+    bool wait(int timeout)
+    {
+        struct pollfd pfd = {m_fd, POLLIN, 0};
+        int ret;
+        while ((ret = poll(&pfd, 1, timeout ? timeout : -1)) < 0 && errno == EINTR) {
+        }
+        return ret > 0;
+    }
+
+    // consume a single signal, wait for it if it wasn't written yet
+    void consume()
+    {
+        uint64_t counter;
+        while (read(m_fd, &counter, sizeof(counter)) != sizeof(counter)) {
+            if (errno == EAGAIN) {
+                wait(0);
+            } else if (errno != EINTR) {
+                return;
+            }
+        }
+    }
+
+private:
+    int m_fd;
+};
+
+/**
+ * Bounded lock-free queues with the push/pop semantics of beerocks::thread_safe_queue.
+ *
+ * pop() returns a default constructed T if the queue is empty (after waiting if block is set, up
+ * to timeout milliseconds or forever if timeout is 0) or if unblock() was called.
+ * push() with block set waits for a free slot when the queue is full, otherwise it fails.
+ * A consumer which also pushes into its own queue must not block on push.
+ *
+ * The eventfd is only written when the queue becomes non-empty and read when it becomes empty,
+ * so a burst of items costs two syscalls instead of two per item.
+ *
+ * Capacity N must be a power of 2. Only a single thread may pop (and clear) the queue.
+ */
+template <typename T, size_t N, typename Derived> class lockfree_queue_base {
+    static_assert(N > 1 && (N & (N - 1)) == 0, "queue capacity must be a power of 2");
+
+public:
+    T pop(bool block = true, int timeout = 0)
+    {
+        T item = T();
+        while (m_pending.load(std::memory_order_acquire) == 0) {
+            if (!block || !m_event.wait(timeout)) {
+                return item;
+            }
+            if (m_unblocked.exchange(false)) {
+                m_event.consume();
+                return item;
+            }
+        }
+
+        derived().dequeue(item);
+        if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // consume the signal of the push which made the queue non-empty
+            m_event.consume();
+        }
+        return item;
+    }
+
+    bool push(const T &item, bool block = true)
+    {
+        T copy(item);
+        return push(std::move(copy), block);
+    }
+
+    bool push(T &&item, bool block = true)
+    {
+        while (!derived().enqueue(item)) {
+            if (!block) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        // counted after the item is published, so a counted item can always be dequeued
+        if (m_pending.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            m_event.signal();
+        }
+        return true;
+    }
+
+    bool empty() { return m_pending.load(std::memory_order_acquire) == 0; }
+
+    void clear()
+    {
+        while (!empty()) {
+            pop(false);
+        }
+    }
+
+    void unblock()
+    {
+        // Unblock the consumer if it is blocked on the pop() method
+        m_unblocked = true;
+        m_event.signal();
+    }
+
+    // -1 if the eventfd couldn't be created, which the owner of the queue must check
+    int get_event_fd() const { return m_event.fd(); }
+
+protected:
+    static constexpr size_t kMask = N - 1;
+
+private:
+    Derived &derived() { return static_cast<Derived &>(*this); }
+
+    queue_event_fd m_event;
+    std::atomic<size_t> m_pending{0};
+    std::atomic<bool> m_unblocked{false};
+};
+
+/**
+ * Single producer, single consumer queue.
+ */
+template <typename T, size_t N>
+class spsc_queue : public lockfree_queue_base<T, N, spsc_queue<T, N>> {
+    friend class lockfree_queue_base<T, N, spsc_queue<T, N>>;
+    using lockfree_queue_base<T, N, spsc_queue<T, N>>::kMask;
+
+    // item is moved only on success
+    bool enqueue(T &item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        m_slots[tail & kMask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool dequeue(T &item)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item                  = std::move(m_slots[head & kMask]);
+        m_slots[head & kMask] = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    T m_slots[N];
+    std::atomic<size_t> m_head{0};
+    // keep the producer and consumer indexes on separate cache lines
+    uint8_t m_padding[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_tail{0};
+};
+
+/**
+ * Multiple producers, single consumer queue.
+ *
+ * Producers claim a slot by advancing the tail and publish it by updating the sequence number of
+ * the slot, so the consumer can tell a claimed slot from a published one.
+ */
+template <typename T, size_t N>
+class mpsc_queue : public lockfree_queue_base<T, N, mpsc_queue<T, N>> {
+    friend class lockfree_queue_base<T, N, mpsc_queue<T, N>>;
+    using lockfree_queue_base<T, N, mpsc_queue<T, N>>::kMask;
+
+public:
+    mpsc_queue()
+    {
+        for (size_t i = 0; i < N; i++) {
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct sSlot {
+        std::atomic<size_t> seq;
+        T data;
+    };
+
+    // item is moved only on success
+    bool enqueue(T &item)
+    {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        sSlot *slot;
+        while (true) {
+            slot       = &m_slots[pos & kMask];
+            size_t seq = slot->seq.load(std::memory_order_acquire);
+            auto diff  = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the consumer didn't free the slot yet
+                return false;
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+        slot->data = std::move(item);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool dequeue(T &item)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        sSlot &slot = m_slots[head & kMask];
+        while (slot.seq.load(std::memory_order_acquire) != head + 1) {
+            if (head == m_tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            // the slot was claimed by a producer which didn't publish it yet, a later slot may
+            // already be published (and signaled), so wait instead of leaving it behind
+            std::this_thread::yield();
+        }
+        item      = std::move(slot.data);
+        slot.data = T();
+        slot.seq.store(head + N, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    sSlot m_slots[N];
+    std::atomic<size_t> m_head{0};
+    // keep the producer and consumer indexes on separate cache lines
+    uint8_t m_padding[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_tail{0};
+};
+
+} // namespace beerocks
+
+#endif // _BEEROCKS_LOCKFREE_QUEUE_H_
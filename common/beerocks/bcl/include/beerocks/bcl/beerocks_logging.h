@@ -9,6 +9,7 @@
 #ifndef _BEEROCKS_LOGGING_H_
 #define _BEEROCKS_LOGGING_H_
 
+#include <atomic>
 #include <map>
 #include <set>
 #include <string>
@@ -17,6 +18,8 @@
 #include "beerocks_defines.h"
 #include "beerocks_string_utils.h"
 
+#include <easylogging++.h>
+
 namespace beerocks {
 #define CONSOLE_MSG(a)                                                                             \
     do {                                                                                           \
@@ -31,6 +34,38 @@ extern const std::string BEEROCKS_LOGGING_MODULE_NAME;
 #define BEEROCKS_INIT_LOGGING(module_name)                                                         \
     const std::string beerocks::BEEROCKS_LOGGING_MODULE_NAME = (module_name);
 
+// Levels compiled in, levels below LOG_MIN_LEVEL are disabled at build time and LOG() of them
+// compiles to nothing
+constexpr uint8_t LOG_LEVELS_COMPILED_MASK =
+    (ELPP_INFO_LOG << LOG_LEVEL_INFO) | (ELPP_DEBUG_LOG << LOG_LEVEL_DEBUG) |
+    (ELPP_ERROR_LOG << LOG_LEVEL_ERROR) | (ELPP_FATAL_LOG << LOG_LEVEL_FATAL) |
+    (ELPP_TRACE_LOG << LOG_LEVEL_TRACE) | (ELPP_WARNING_LOG << LOG_LEVEL_WARNING);
+
+// Levels enabled by the last applied logging settings, as a log_levels mask
+extern std::atomic<uint8_t> g_log_levels_mask;
+
+/**
+ * Cheap check of a log level, done before the log line is built.
+ */
+inline bool log_level_enabled(eLogLevel log_level)
+{
+    return (LOG_LEVELS_COMPILED_MASK & (1 << log_level)) &&
+           (g_log_levels_mask.load(std::memory_order_relaxed) & (1 << log_level));
+}
+
+class log_voidify {
+public:
+    template <typename T> void operator&(const T &) {}
+};
+
+/**
+ * LOG(a) which doesn't build the log line, including the evaluation of the streamed
+ * expressions, if level a is disabled.
+ */
+#define LOG_IF_ENABLED(a)                                                                          \
+    !beerocks::log_level_enabled(beerocks::LOG_LEVEL_##a) ? (void)0                                \
+                                                          : beerocks::log_voidify() & LOG(a)
+
 class log_levels {
 public:
     typedef std::set<std::string> set_t;
@@ -47,20 +82,25 @@ public:
     std::string to_string();
     void parse_string(const std::string &log_level_str);
 
-    bool is_all();
-    bool is_off();
+    bool is_all() const;
+    bool is_off() const;
 
-    bool fatal_enabled();
-    bool error_enabled();
-    bool warning_enabled();
-    bool info_enabled();
-    bool debug_enabled();
-    bool trace_enabled();
+    bool fatal_enabled() const;
+    bool error_enabled() const;
+    bool warning_enabled() const;
+    bool info_enabled() const;
+    bool debug_enabled() const;
+    bool trace_enabled() const;
 
     void set_log_level_state(const eLogLevel &log_level, const bool &new_state);
 
+    // bit n is set if eLogLevel n is enabled
+    uint8_t get_mask() const { return m_level_mask; }
+
 private:
-    std::set<std::string> m_level_set;
+    bool level_enabled(eLogLevel log_level) const { return m_level_mask & (1 << log_level); }
+
+    uint8_t m_level_mask = 0;
 };
 
 extern const log_levels LOG_LEVELS_ALL;
@@ -79,7 +119,7 @@ public:
             std::string module_name = BEEROCKS_LOGGING_MODULE_NAME);
     logging(const beerocks::config_file::SConfigLog &settings, std::string module_name,
             bool cache_settings = false);
-    ~logging() = default;
+    ~logging();
 
     void apply_settings();
 
@@ -91,6 +131,10 @@ public:
     log_levels get_log_levels();
     log_levels get_syslog_levels();
     std::string get_syslog_enabled();
+    std::string get_async_enabled();
+
+    // number of log lines dropped by the async writer since the process started
+    static uint64_t get_async_dropped_count();
 
     void set_log_level_state(const eLogLevel &log_level, const bool &new_state);
 
@@ -123,6 +167,7 @@ private:
     std::string m_netlog_host;
     uint16_t m_netlog_port;
     std::string m_syslog_enabled;
+    std::string m_async_enabled;
 
     settings_t m_settings_map;
 };
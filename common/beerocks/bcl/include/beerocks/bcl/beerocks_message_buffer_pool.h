@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BEEROCKS_MESSAGE_BUFFER_POOL_H_
+#define _BEEROCKS_MESSAGE_BUFFER_POOL_H_
+
+#include "beerocks_message_structs.h"
+
+#include <tlvf/CmduMessageTx.h>
+
+#include <memory>
+#include <vector>
+
+namespace beerocks {
+
+/**
+ * Process wide pool of large message buffers.
+ *
+ * Messages up to message::MESSAGE_BUFFER_LENGTH are handled in the fixed buffers of each thread.
+ * Larger local messages (up to message::MESSAGE_BUFFER_LENGTH_MAX) borrow a buffer from the pool
+ * while they are built or received, so the memory is not held by every thread and socket.
+ */
+class message_buffer_pool {
+public:
+    typedef std::shared_ptr<std::vector<uint8_t>> buffer_ptr;
+
+    /**
+     * @brief Get a buffer of at least size bytes, it is returned to the pool once released
+     */
+    static buffer_ptr get(size_t size = message::MESSAGE_BUFFER_LENGTH_MAX);
+
+private:
+    static void put(std::vector<uint8_t> *buffer);
+};
+
+/**
+ * CmduMessageTx for a large local message, built on a buffer borrowed from the pool.
+ * The UDS header is reserved in front of the CMDU as in the cmdu_tx of socket_thread.
+ */
+class large_cmdu_tx {
+public:
+    large_cmdu_tx(size_t size = message::MESSAGE_BUFFER_LENGTH_MAX);
+
+    ieee1905_1::CmduMessageTx &get() { return m_cmdu_tx; }
+
+private:
+    message_buffer_pool::buffer_ptr m_buffer;
+    ieee1905_1::CmduMessageTx m_cmdu_tx;
+};
+
+} // namespace beerocks
+
+#endif // _BEEROCKS_MESSAGE_BUFFER_POOL_H_
@@ -9,6 +9,7 @@
 #ifndef _BEEROCKS_SOCKET_THREAD_H_
 #define _BEEROCKS_SOCKET_THREAD_H_
 
+#include "beerocks_message_buffer_pool.h"
 #include "beerocks_message_structs.h"
 #include "beerocks_thread_base.h"
 #include "network/socket.h"
@@ -16,6 +17,10 @@
 #include <tlvf/CmduMessageRx.h>
 #include <tlvf/CmduMessageTx.h>
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #define DEFAULT_SELECT_TIMEOUT_MS 500
 
 namespace beerocks {
@@ -47,7 +52,10 @@ protected:
     virtual int server_port() { return -1; }
 
     virtual void add_socket(Socket *s, bool add_to_vector = true) { select.addSocket(s); }
-    virtual void remove_socket(Socket *s) { select.removeSocket(s); }
+    virtual void remove_socket(Socket *s);
+    // Drops the bytes received on the socket and not dispatched yet, overrides of
+    // remove_socket() which don't call the base one must call it
+    void clear_rx_buffer(Socket *s);
     inline void clear_ready(Socket *s) { select.clearReady(s); }
     virtual bool read_ready(Socket *s) { return select.readReady(s); }
 
@@ -62,8 +70,20 @@ private:
     bool handle_cmdu_message_uds(Socket *sd);
     bool verify_cmdu(message::sUdsHeader *uds_header);
 
+    // Bytes which were read from a UDS socket and not dispatched yet.
+    // Holds several messages, the last one may be partially received.
+    struct sRxBuffer {
+        std::vector<uint8_t> data;
+        // borrowed from the pool while receiving a message longer than data
+        message_buffer_pool::buffer_ptr large;
+        size_t len = 0;
+
+        uint8_t *buf() { return large ? large->data() : data.data(); }
+        size_t size() { return large ? large->size() : data.size(); }
+    };
+
     std::string unix_socket_path;
-    uint8_t rx_buffer[message::MESSAGE_BUFFER_LENGTH];
+    std::unordered_map<Socket *, std::shared_ptr<sRxBuffer>> rx_buffers;
     uint8_t tx_buffer[message::MESSAGE_BUFFER_LENGTH];
     ieee1905_1::CmduMessageRx cmdu_rx;
 
@@ -9,7 +9,9 @@
 #ifndef _BEEROCKS_THREAD_BASE_H_
 #define _BEEROCKS_THREAD_BASE_H_
 
-#define THREAD_LOG(a) (LOG(a) << get_name() << ": ")
+#define THREAD_LOG(a) LOG_IF_ENABLED(a) << get_name() << ": "
+
+#include "beerocks_logging.h"
 
 #include <atomic>
 #include <string>
@@ -27,6 +27,7 @@ typedef unsigned __int64 ssize_t;
 #include <netdb.h>
 #include <netinet/in.h>
 #include <string.h>
+#include <sys/epoll.h>
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
@@ -38,6 +39,7 @@ typedef unsigned __int64 ssize_t;
 
 #include <cstdint>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -97,6 +99,9 @@ protected:
 
 private:
     static int m_ref;
+    // a stream socket may be written from more than one thread, writeBytes() keeps each
+    // message in one piece
+    std::mutex m_write_mutex;
 };
 
 class SocketClient : public Socket {
@@ -117,7 +122,13 @@ public:
 
 class SocketSelect {
 public:
-    SocketSelect();
+    // Readiness notification mechanism
+    enum eBackend {
+        BACKEND_SELECT, // select() over an fd_set rebuilt on every call
+        BACKEND_EPOLL,  // epoll() with the sockets registered once, no FD_SETSIZE limit
+    };
+
+    SocketSelect(eBackend backend = BACKEND_SELECT);
     ~SocketSelect();
     void setTimeout(timeval *tval);
     void addSocket(Socket *s);
@@ -127,8 +138,12 @@ public:
     int selectSocket();
     bool readReady(const Socket *s);
     bool readReady(size_t idx);
+    // Pop the next socket which was found ready by the last selectSocket() call and was not
+    // cleared or removed since, or nullptr if there are none left
+    Socket *nextReady();
     int count() { return (int)m_socketVec.size(); }
     bool isBlocking() { return m_isBlocking; }
+    eBackend getBackend() { return m_backend; }
     std::string getError()
     {
         return m_error;
@@ -137,10 +152,16 @@ public:
 
 private:
     bool m_isBlocking;
+    eBackend m_backend;
     std::vector<Socket *> m_socketVec;
+    std::vector<Socket *> m_readyVec;
     fd_set m_socketSet;
     timeval *m_socketTval;
     std::string m_error;
+#ifndef IS_WINDOWS
+    int m_epoll_fd = -1;
+    std::vector<struct epoll_event> m_epoll_events;
+#endif
 };
 
 #endif
@@ -7,18 +7,23 @@
  */
 
 #include "../include/beerocks/bcl/beerocks_logging.h"
+#include "../include/beerocks/bcl/beerocks_lockfree_queue.h"
 #include "../include/beerocks/bcl/beerocks_os_utils.h"
 #include "../include/beerocks/bcl/network/socket.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <linux/limits.h>
+#include <thread>
 #include <unistd.h>
 
 #include <easylogging++.h>
 
 #define LOG_MAX_LEVELS 6
 #define LOGGING_DEFAULT_MAX_SIZE (size_t)100000
+#define ASYNC_LOG_QUEUE_SIZE 1024
+#define ASYNC_LOG_FLUSH_TIMEOUT_MS 1000
 
 // Use the easylogging++ instance from the parent process
 SHARE_EASYLOGGINGPP(el::Helpers::storage())
@@ -34,7 +39,9 @@ public:
         }
     }
 
-    void handle(const el::LogDispatchData *logData)
+    void handle(const el::LogDispatchData *logData) { check(logData->logMessage()->logger()); }
+
+    void check(el::Logger *logger)
     {
 
         //////////////////////////////
@@ -46,18 +53,14 @@ public:
         }
 
         if (!m_fsLogFileStream) {
-            if (!(m_fsLogFileStream =
-                      logData->logMessage()->logger()->typedConfigurations()->fileStream(
-                          el::Level::Info))) {
+            if (!(m_fsLogFileStream = logger->typedConfigurations()->fileStream(el::Level::Info))) {
                 return;
             }
         }
 
         if (!m_szRollLogFileSize) {
             if (!(m_szRollLogFileSize =
-                      (logData->logMessage()->logger()->typedConfigurations()->maxLogFileSize(
-                           el::Level::Info) /
-                       2))) {
+                      (logger->typedConfigurations()->maxLogFileSize(el::Level::Info) / 2))) {
                 return;
             }
         }
@@ -109,23 +112,259 @@ public:
         this->setEnabled(true);
     }
 
+    bool configured() const { return m_port > 0; }
+
+    void send(const std::string &log_line)
+    {
+        SocketClient logmaster(m_server, m_port);
+        logmaster.writeString(m_module_name + ": " + log_line);
+    }
+
 protected:
     void handle(const el::LogDispatchData *logdata) noexcept override
     {
-        std::string msg = m_module_name + ": " +
-                          logdata->logMessage()->logger()->logBuilder()->build(
-                              logdata->logMessage(),
-                              logdata->dispatchAction() == el::base::DispatchAction::NormalLog);
-        SocketClient logmaster(m_server, m_port);
-        logmaster.writeString(msg);
+        send(logdata->logMessage()->logger()->logBuilder()->build(
+            logdata->logMessage(),
+            logdata->dispatchAction() == el::base::DispatchAction::NormalLog));
     }
 
 private:
     std::string m_server;
-    uint16_t m_port;
+    uint16_t m_port = 0;
     std::string m_module_name;
 };
 
+/**
+ * Asynchronous log output.
+ *
+ * Replaces the default easylogging++ dispatch callback while enabled. The logging thread only
+ * builds the log line (the timestamp and thread id belong to the call site) and pushes it into a
+ * lock-free queue. A writer thread writes the lines to the log file, syslog and network logger,
+ * flushes the file once per burst instead of once per line and runs the roll monitor.
+ * Lines are dropped and counted when the queue is full, the writer thread reports the number
+ * of dropped lines in the log file.
+ */
+class AsyncLogWriter : public el::LogDispatchCallback {
+public:
+    ~AsyncLogWriter()
+    {
+        // The other callbacks may already be destructed, only stop the thread
+        m_detached = true;
+        stop_thread();
+    }
+
+    bool start()
+    {
+        if (m_running) {
+            return true;
+        }
+        // The writer thread would never be woken up
+        if (m_queue.get_event_fd() < 0) {
+            return false;
+        }
+        m_running = true;
+        m_thread  = std::thread(&AsyncLogWriter::run, this);
+
+        set_sync_callbacks_enabled(false);
+        this->setEnabled(true);
+        return true;
+    }
+
+    void stop()
+    {
+        if (!m_running) {
+            return;
+        }
+        this->setEnabled(false);
+        set_sync_callbacks_enabled(true);
+        stop_thread();
+    }
+
+    uint64_t dropped() const { return m_dropped; }
+
+protected:
+    void handle(const el::LogDispatchData *data) noexcept override
+    {
+
+        //////////////////////////////
+        // DO NOT USE LOGGING HERE! //
+        //////////////////////////////
+
+        auto msg = data->logMessage();
+        auto tc  = msg->logger()->typedConfigurations();
+
+        sLogRecord record;
+        record.level  = msg->level();
+        record.logger = msg->logger();
+        record.line   = msg->logger()->logBuilder()->build(
+            msg, data->dispatchAction() == el::base::DispatchAction::NormalLog);
+        if (tc->toFile(record.level)) {
+            record.fs = tc->sharedFileStream(record.level);
+        }
+#if defined(ELPP_SYSLOG)
+        if (tc->toSyslog(record.level)) {
+            el::LogMessage syslog_msg(msg->level(), msg->file(), msg->line(), msg->func(),
+                                      msg->verboseLevel(),
+                                      el::Loggers::getLogger(el::base::consts::kSysLogLoggerId),
+                                      msg->message());
+            record.syslog_line = syslog_msg.logger()->logBuilder()->build(&syslog_msg, false);
+        }
+#endif // defined(ELPP_SYSLOG)
+
+        if (!m_queue.push(std::move(record), false)) {
+            m_dropped++;
+            return;
+        }
+        auto queued = ++m_queued;
+
+        // Don't lose the last words of the process
+        if (msg->level() == el::Level::Fatal) {
+            wait_written(queued);
+        }
+    }
+
+private:
+    struct sLogRecord {
+        el::Level level    = el::Level::Unknown;
+        el::Logger *logger = nullptr;
+        el::base::FileStreamPtr fs;
+        std::string line;
+        std::string syslog_line;
+    };
+
+    void set_sync_callbacks_enabled(bool enabled)
+    {
+        auto default_dispatcher = el::Helpers::logDispatchCallback<
+            el::base::DefaultLogDispatchCallback>("DefaultLogDispatchCallback");
+        if (default_dispatcher) {
+            default_dispatcher->setEnabled(enabled);
+        }
+        // The roll monitor and the network logger are run by the writer thread
+        auto roll_monitor = el::Helpers::logDispatchCallback<RollMonitor>("RollMonitor");
+        if (roll_monitor) {
+            roll_monitor->setEnabled(enabled);
+        }
+        auto net_logger = el::Helpers::logDispatchCallback<NetLogger>("NetLogger");
+        if (net_logger && net_logger->configured()) {
+            net_logger->setEnabled(enabled);
+        }
+    }
+
+    void stop_thread()
+    {
+        m_running = false;
+        m_queue.unblock();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void wait_written(uint64_t queued)
+    {
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(ASYNC_LOG_FLUSH_TIMEOUT_MS);
+        while (m_written < queued && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+
+    void run()
+    {
+        m_roll_monitor = el::Helpers::logDispatchCallback<RollMonitor>("RollMonitor");
+        m_net_logger   = el::Helpers::logDispatchCallback<NetLogger>("NetLogger");
+        if (m_net_logger && !m_net_logger->configured()) {
+            m_net_logger = nullptr;
+        }
+
+        while (m_running) {
+            write_burst(m_queue.pop());
+        }
+        // Write the lines queued before the writer was stopped
+        write_burst(m_queue.pop(false));
+    }
+
+    void write_burst(sLogRecord record)
+    {
+        el::Logger *logger = nullptr;
+        el::base::FileStreamPtr fs;
+        for (; record.logger; record = m_queue.pop(false)) {
+            if (record.fs != fs) {
+                if (fs) {
+                    fs->flush();
+                }
+                fs = record.fs;
+            }
+            write(record);
+            logger = record.logger;
+            m_written++;
+        }
+        if (!logger) {
+            return;
+        }
+
+        auto dropped = m_dropped.load();
+        if (fs && dropped != m_reported_drops) {
+            auto line = std::to_string(dropped - m_reported_drops) +
+                        " log lines were dropped, the async log queue was full\n";
+            fs->write(line.c_str(), line.size());
+            m_reported_drops = dropped;
+        }
+        if (fs) {
+            fs->flush();
+        }
+        if (m_roll_monitor && !m_detached) {
+            m_roll_monitor->check(logger);
+        }
+    }
+
+    void write(const sLogRecord &record)
+    {
+        if (record.fs) {
+            record.fs->write(record.line.c_str(), record.line.size());
+        }
+#if defined(ELPP_SYSLOG)
+        if (!record.syslog_line.empty()) {
+            int priority;
+            switch (record.level) {
+            case el::Level::Fatal:
+                priority = LOG_EMERG;
+                break;
+            case el::Level::Error:
+                priority = LOG_ERR;
+                break;
+            case el::Level::Warning:
+                priority = LOG_WARNING;
+                break;
+            case el::Level::Info:
+                priority = LOG_INFO;
+                break;
+            case el::Level::Debug:
+                priority = LOG_DEBUG;
+                break;
+            default:
+                priority = LOG_NOTICE;
+                break;
+            }
+            syslog(priority, "%s", record.syslog_line.c_str());
+        }
+#endif // defined(ELPP_SYSLOG)
+        if (m_net_logger && !m_detached) {
+            m_net_logger->send(record.line);
+        }
+    }
+
+    beerocks::mpsc_queue<sLogRecord, ASYNC_LOG_QUEUE_SIZE> m_queue;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_detached{false};
+    std::atomic<uint64_t> m_queued{0};
+    std::atomic<uint64_t> m_written{0};
+    std::atomic<uint64_t> m_dropped{0};
+    uint64_t m_reported_drops  = 0;
+    RollMonitor *m_roll_monitor = nullptr;
+    NetLogger *m_net_logger     = nullptr;
+};
+
 static std::string log_level_to_string(const beerocks::eLogLevel &log_level)
 {
     std::string log_level_str;
@@ -167,35 +406,59 @@ const log_levels LOG_LEVELS_GLOBAL_DEFAULT =
 const log_levels LOG_LEVELS_MODULE_DEFAULT =
     log_levels(log_levels::set_t({"debug", "error", "fatal", "info", "trace", "warning"}));
 const log_levels LOG_LEVELS_SYSLOG_DEFAULT = log_levels(log_levels::set_t({"error", "fatal"}));
+
+// All the levels are enabled until logging settings are applied
+std::atomic<uint8_t> g_log_levels_mask(0xFF);
 } // namespace beerocks
 
 using namespace beerocks;
 
-log_levels::log_levels(const std::set<std::string> &log_levels) : m_level_set(log_levels) {}
+// sorted by name, like the string representation of the levels
+static const eLogLevel s_log_levels[LOG_MAX_LEVELS] = {LOG_LEVEL_DEBUG, LOG_LEVEL_ERROR,
+                                                       LOG_LEVEL_FATAL, LOG_LEVEL_INFO,
+                                                       LOG_LEVEL_TRACE, LOG_LEVEL_WARNING};
+
+static uint8_t log_level_bit(const eLogLevel &log_level) { return uint8_t(1 << log_level); }
+
+static uint8_t log_level_string_to_bit(const std::string &log_level_str)
+{
+    for (auto log_level : s_log_levels) {
+        if (log_level_to_string(log_level) == log_level_str) {
+            return log_level_bit(log_level);
+        }
+    }
+    return 0;
+}
+
+log_levels::log_levels(const std::set<std::string> &log_levels)
+{
+    for (auto &log_level_str : log_levels) {
+        m_level_mask |= log_level_string_to_bit(log_level_str);
+    }
+}
 
 log_levels::log_levels(const std::string &log_level_str) { parse_string(log_level_str); }
 
 log_levels &log_levels::operator=(const log_levels &rhs)
 {
     if (&rhs != this) {
-        m_level_set = rhs.m_level_set;
+        m_level_mask = rhs.m_level_mask;
     }
     return *this;
 }
 
 log_levels &log_levels::operator=(const std::string &log_level_str)
 {
-    m_level_set.clear();
+    m_level_mask = 0;
     parse_string(log_level_str);
     return *this;
 }
 
 log_levels log_levels::operator&(const log_levels &rhs)
 {
-    set_t intersect;
-    std::set_intersection(m_level_set.begin(), m_level_set.end(), rhs.m_level_set.begin(),
-                          rhs.m_level_set.end(), std::inserter(intersect, intersect.begin()));
-    return log_levels(intersect);
+    log_levels intersect;
+    intersect.m_level_mask = m_level_mask & rhs.m_level_mask;
+    return intersect;
 }
 
 void log_levels::parse_string(const std::string &str)
@@ -215,16 +478,17 @@ void log_levels::parse_string(const std::string &str)
         std::transform(token.begin(), token.end(), token.begin(), ::tolower);
         if ("all" == token) {
             // ignore any additional tokens
-            token_end   = std::string::npos;
-            m_level_set = LOG_LEVELS_ALL.m_level_set;
+            token_end    = std::string::npos;
+            m_level_mask = LOG_LEVELS_ALL.m_level_mask;
         } else if ("off" == token) {
             // ignore any additional tokens
-            token_end   = std::string::npos;
-            m_level_set = LOG_LEVELS_OFF.m_level_set;
+            token_end    = std::string::npos;
+            m_level_mask = LOG_LEVELS_OFF.m_level_mask;
         } else {
-            if (LOG_LEVELS_ALL.m_level_set.end() != LOG_LEVELS_ALL.m_level_set.find(token)) {
+            auto bit = log_level_string_to_bit(token);
+            if (bit) {
                 // valid token
-                m_level_set.insert(token);
+                m_level_mask |= bit;
             } else {
                 LOG(WARNING) << "loglevel invalid token: " << token;
                 // ignore invalid tokens
@@ -238,51 +502,51 @@ void log_levels::set_log_level_state(const eLogLevel &log_level, const bool &new
 {
     if (log_level == LOG_LEVEL_ALL) {
         if (new_state) {
-            m_level_set = LOG_LEVELS_ALL.m_level_set;
+            m_level_mask = LOG_LEVELS_ALL.m_level_mask;
         } else {
-            m_level_set = LOG_LEVELS_OFF.m_level_set;
+            m_level_mask = LOG_LEVELS_OFF.m_level_mask;
         }
     } else if (log_level != LOG_LEVEL_NONE) {
-        std::string log_level_str = log_level_to_string(log_level);
-        if (!log_level_str.empty()) {
-            if (new_state) {
-                m_level_set.insert(log_level_str);
-            } else {
-                m_level_set.erase(log_level_str);
-            }
+        uint8_t bit = log_level_string_to_bit(log_level_to_string(log_level));
+        if (new_state) {
+            m_level_mask |= bit;
+        } else {
+            m_level_mask &= ~bit;
         }
     }
 }
 
 std::string log_levels::to_string()
 {
-    if (m_level_set.size() < 1) {
+    if (is_off()) {
         return std::string();
     }
 
     std::string str;
-    for (auto &elt : m_level_set) {
-        str += elt + ", ";
+    for (auto log_level : s_log_levels) {
+        if (level_enabled(log_level)) {
+            str += log_level_to_string(log_level) + ", ";
+        }
     }
     str.erase(str.size() - 2);
     return str;
 }
 
-bool log_levels::is_all() { return (m_level_set.size() == LOG_MAX_LEVELS); }
+bool log_levels::is_all() const { return (m_level_mask == LOG_LEVELS_ALL.m_level_mask); }
 
-bool log_levels::is_off() { return (m_level_set.size() == 0); }
+bool log_levels::is_off() const { return (m_level_mask == 0); }
 
-bool log_levels::fatal_enabled() { return (m_level_set.end() != m_level_set.find("fatal")); }
+bool log_levels::fatal_enabled() const { return level_enabled(LOG_LEVEL_FATAL); }
 
-bool log_levels::error_enabled() { return (m_level_set.end() != m_level_set.find("error")); }
+bool log_levels::error_enabled() const { return level_enabled(LOG_LEVEL_ERROR); }
 
-bool log_levels::warning_enabled() { return (m_level_set.end() != m_level_set.find("warning")); }
+bool log_levels::warning_enabled() const { return level_enabled(LOG_LEVEL_WARNING); }
 
-bool log_levels::info_enabled() { return (m_level_set.end() != m_level_set.find("info")); }
+bool log_levels::info_enabled() const { return level_enabled(LOG_LEVEL_INFO); }
 
-bool log_levels::debug_enabled() { return (m_level_set.end() != m_level_set.find("debug")); }
+bool log_levels::debug_enabled() const { return level_enabled(LOG_LEVEL_DEBUG); }
 
-bool log_levels::trace_enabled() { return (m_level_set.end() != m_level_set.find("trace")); }
+bool log_levels::trace_enabled() const { return level_enabled(LOG_LEVEL_TRACE); }
 
 //====================================================================================
 // logging
@@ -293,7 +557,7 @@ const std::string logging::syslogFormat("[beerocks] <%thread> %fbase[%line] -->
 logging::logging(const std::string config_path, std::string module_name)
     : m_module_name(module_name), m_logfile_size(LOGGING_DEFAULT_MAX_SIZE),
       m_levels(LOG_LEVELS_GLOBAL_DEFAULT), m_syslog_levels(LOG_LEVELS_SYSLOG_DEFAULT),
-      m_netlog_host(""), m_netlog_port(0), m_syslog_enabled("false")
+      m_netlog_host(""), m_netlog_port(0), m_syslog_enabled("false"), m_async_enabled("false")
 {
     bool found_settings = false;
 
@@ -314,7 +578,7 @@ logging::logging(const std::string config_path, std::string module_name)
 logging::logging(const settings_t &settings, bool cache_settings, std::string module_name)
     : m_module_name(module_name), m_logfile_size(LOGGING_DEFAULT_MAX_SIZE),
       m_levels(LOG_LEVELS_GLOBAL_DEFAULT), m_syslog_levels(LOG_LEVELS_SYSLOG_DEFAULT),
-      m_netlog_host(""), m_netlog_port(0), m_syslog_enabled("false")
+      m_netlog_host(""), m_netlog_port(0), m_syslog_enabled("false"), m_async_enabled("false")
 {
     for (auto &setting : settings) {
         if (0 == setting.first.find("log_")) {
@@ -333,7 +597,7 @@ logging::logging(const beerocks::config_file::SConfigLog &settings, std::string
                  bool cache_settings)
     : m_module_name(module_name), m_logfile_size(LOGGING_DEFAULT_MAX_SIZE),
       m_levels(LOG_LEVELS_GLOBAL_DEFAULT), m_syslog_levels(LOG_LEVELS_SYSLOG_DEFAULT),
-      m_netlog_host(""), m_netlog_port(0), m_syslog_enabled("false")
+      m_netlog_host(""), m_netlog_port(0), m_syslog_enabled("false"), m_async_enabled("false")
 {
     m_settings_map.insert({"log_path", settings.path});
     m_settings_map.insert({"log_global_levels", settings.global_levels});
@@ -344,6 +608,9 @@ logging::logging(const beerocks::config_file::SConfigLog &settings, std::string
     } else {
         m_settings_map.insert({"log_syslog_enabled", "false"});
     }
+    if (!settings.async_enabled.empty()) {
+        m_settings_map.insert({"log_async_enabled", settings.async_enabled});
+    }
     if (!settings.netlog_host.empty()) {
         m_settings_map.insert({"log_netlog_host", settings.netlog_host});
         m_settings_map.insert({"log_netlog_port", settings.netlog_port});
@@ -352,6 +619,17 @@ logging::logging(const beerocks::config_file::SConfigLog &settings, std::string
     eval_settings();
 }
 
+logging::~logging()
+{
+    // Write the queued log lines while the easylogging++ storage is still valid
+    if (get_async_enabled() == "true") {
+        auto async_writer = el::Helpers::logDispatchCallback<AsyncLogWriter>("AsyncLogWriter");
+        if (async_writer) {
+            async_writer->stop();
+        }
+    }
+}
+
 std::string logging::get_module_name() { return m_module_name; }
 
 std::string logging::get_config_path(std::string config_path)
@@ -422,6 +700,17 @@ log_levels logging::get_syslog_levels() { return m_syslog_levels; }
 
 std::string logging::get_syslog_enabled() { return m_syslog_enabled; }
 
+std::string logging::get_async_enabled() { return m_async_enabled; }
+
+uint64_t logging::get_async_dropped_count()
+{
+    auto async_writer = el::Helpers::logDispatchCallback<AsyncLogWriter>("AsyncLogWriter");
+    if (!async_writer) {
+        return 0;
+    }
+    return async_writer->dropped();
+}
+
 void logging::set_log_level_state(const eLogLevel &log_level, const bool &new_state)
 {
     m_levels.set_log_level_state(log_level, new_state);
@@ -442,6 +731,12 @@ void logging::handle_logging_rollover(const char *log_name, std::size_t)
 }
 void logging::apply_settings()
 {
+    // Stop the async writer before reconfiguring the loggers it writes to
+    auto async_writer = el::Helpers::logDispatchCallback<AsyncLogWriter>("AsyncLogWriter");
+    if (async_writer) {
+        async_writer->stop();
+    }
+
     // Disable The instance of RollMonitor to start fresh
     {
         auto roll_monitor = el::Helpers::logDispatchCallback<RollMonitor>("RollMonitor");
@@ -493,11 +788,18 @@ void logging::apply_settings()
 
     el::Loggers::reconfigureLogger("default", defaultConf);
     el::Loggers::reconfigureLogger("syslog", syslogConf);
+    g_log_levels_mask = m_levels.get_mask();
 
     el::Loggers::addFlag(el::LoggingFlag::ImmediateFlush);
     el::Loggers::addFlag(el::LoggingFlag::LogDetailedCrashReason);
     el::Loggers::addFlag(el::LoggingFlag::DisableApplicationAbortOnFatalLog);
-    el::Loggers::addFlag(el::LoggingFlag::StrictLogFileSizeCheck);
+    if (get_async_enabled() == "true") {
+        // The file size check of easylogging++ would race with the async writer, the roll
+        // monitor run by the writer takes care of the log size
+        el::Loggers::removeFlag(el::LoggingFlag::StrictLogFileSizeCheck);
+    } else {
+        el::Loggers::addFlag(el::LoggingFlag::StrictLogFileSizeCheck);
+    }
 
     // Create symbolic links to the log file
     auto logger = el::Loggers::getLogger("default");
@@ -539,6 +841,24 @@ void logging::apply_settings()
         nlg->enable(m_netlog_host, m_netlog_port, m_module_name);
         LOG(INFO) << "Netlogger enabled.";
     }
+
+    if (get_async_enabled() == "true") {
+        if (!async_writer) {
+            el::Helpers::installLogDispatchCallback<AsyncLogWriter>("AsyncLogWriter");
+            async_writer = el::Helpers::logDispatchCallback<AsyncLogWriter>("AsyncLogWriter");
+            if (!async_writer) {
+                LOG(ERROR) << "invalid AsyncLogWriter!";
+                return;
+            }
+            // Installed callbacks are enabled, don't dispatch to it before it is started
+            async_writer->setEnabled(false);
+        }
+        if (!async_writer->start()) {
+            LOG(ERROR) << "Failed creating the async log queue, logging synchronously";
+            return;
+        }
+        LOG(INFO) << "Async logging enabled.";
+    }
 }
 
 bool logging::load_settings(const std::string &config_file_path)
@@ -688,4 +1008,17 @@ void logging::eval_settings()
     } else {
         m_syslog_enabled = "false"; // If no module specific setting, accept a global, then default
     }
+
+    //async_enabled
+    setting             = m_settings_map.find("log_async_enabled");
+    module_setting_name = std::string("log_") + m_module_name + std::string("_async_enabled");
+    module_setting      = m_settings_map.find(module_setting_name);
+
+    if (module_setting != m_settings_map.end()) {
+        m_async_enabled = module_setting->second;
+    } else if (setting != m_settings_map.end()) {
+        m_async_enabled = setting->second;
+    } else {
+        m_async_enabled = "false"; // If no module specific setting, accept a global, then default
+    }
 }
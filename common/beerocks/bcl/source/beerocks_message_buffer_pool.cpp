@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "../include/beerocks/bcl/beerocks_message_buffer_pool.h"
+
+#include <cstring>
+#include <mutex>
+
+using namespace beerocks;
+
+// Free buffers above this number are released to the system
+#define MAX_POOLED_BUFFERS 4
+
+static std::mutex s_pool_mutex;
+static std::vector<std::unique_ptr<std::vector<uint8_t>>> s_pool;
+
+message_buffer_pool::buffer_ptr message_buffer_pool::get(size_t size)
+{
+    std::unique_ptr<std::vector<uint8_t>> buffer;
+    {
+        std::lock_guard<std::mutex> lock(s_pool_mutex);
+        if (!s_pool.empty()) {
+            buffer = std::move(s_pool.back());
+            s_pool.pop_back();
+        }
+    }
+
+    if (!buffer) {
+        buffer = std::unique_ptr<std::vector<uint8_t>>(new std::vector<uint8_t>());
+    }
+    if (buffer->size() < size) {
+        buffer->resize(size);
+    }
+
+    return buffer_ptr(buffer.release(), put);
+}
+
+void message_buffer_pool::put(std::vector<uint8_t> *buffer)
+{
+    std::unique_ptr<std::vector<uint8_t>> owner(buffer);
+
+    std::lock_guard<std::mutex> lock(s_pool_mutex);
+    if (s_pool.size() < MAX_POOLED_BUFFERS) {
+        s_pool.push_back(std::move(owner));
+    }
+}
+
+large_cmdu_tx::large_cmdu_tx(size_t size)
+    : m_buffer(message_buffer_pool::get(size)),
+      m_cmdu_tx(m_buffer->data() + sizeof(message::sUdsHeader),
+                m_buffer->size() - sizeof(message::sUdsHeader))
+{
+    // same as the cmdu_tx of socket_thread, the UDS header is filled when sending
+    std::memset(m_buffer->data(), 0, sizeof(message::sUdsHeader));
+}
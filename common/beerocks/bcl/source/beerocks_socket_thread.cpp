@@ -15,6 +15,9 @@
 #include <tlvf/CmduMessageRx.h>
 #include <tlvf/ieee_1905_1/eTlvType.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace beerocks;
 
 typedef struct sTlvHeader {
@@ -25,11 +28,13 @@ typedef struct sTlvHeader {
 #define DEFAULT_MAX_SOCKET_CONNECTIONS 10
 #define TX_BUFFER_UDS (tx_buffer + sizeof(beerocks::message::sUdsHeader))
 #define TX_BUFFER_UDS_SIZE (sizeof(tx_buffer) - sizeof(beerocks::message::sUdsHeader))
+// Large enough to hold several messages, so all the pending ones are read with a single call
+#define RX_BUFFER_UDS_SIZE (4 * beerocks::message::MESSAGE_BUFFER_LENGTH)
 
 socket_thread::socket_thread(const std::string &unix_socket_path_)
     : thread_base(), cmdu_tx(TX_BUFFER_UDS, TX_BUFFER_UDS_SIZE),
       unix_socket_path(unix_socket_path_), server_socket(nullptr),
-      server_max_connections(DEFAULT_MAX_SOCKET_CONNECTIONS)
+      server_max_connections(DEFAULT_MAX_SOCKET_CONNECTIONS), select(SocketSelect::BACKEND_EPOLL)
 {
     memset(TX_BUFFER_UDS, 0, TX_BUFFER_UDS_SIZE);
     set_select_timeout(500);
@@ -99,6 +104,14 @@ void socket_thread::set_select_timeout(unsigned msec)
     select.setTimeout(&tv);
 }
 
+void socket_thread::remove_socket(Socket *s)
+{
+    clear_rx_buffer(s);
+    select.removeSocket(s);
+}
+
+void socket_thread::clear_rx_buffer(Socket *s) { rx_buffers.erase(s); }
+
 void socket_thread::socket_connected(Socket *sd)
 {
     if (sd == nullptr) {
@@ -110,11 +123,23 @@ void socket_thread::socket_connected(Socket *sd)
 
 int socket_thread::socket_disconnected_uds(Socket *sd)
 {
-    // Dummy read for disconnected check
+    // Read all the pending bytes into the socket receive buffer (non-blocking), the messages are
+    // dispatched by handle_cmdu_message_uds(). Reading 0 bytes means the peer disconnected.
+    auto &rx = rx_buffers[sd];
+    if (!rx) {
+        rx = std::make_shared<sRxBuffer>();
+        rx->data.resize(RX_BUFFER_UDS_SIZE);
+    }
+
+    size_t free_bytes = rx->size() - rx->len;
+    if (free_bytes == 0) {
+        // nothing can be read until the buffered messages are dispatched
+        return 0;
+    }
 
-    ssize_t available_bytes = sd->readBytes(rx_buffer, sizeof(rx_buffer), false, 1,
-                                            true); // try to read 1 byte, non-blocking
+    ssize_t available_bytes = sd->readBytes(rx->buf() + rx->len, free_bytes, false, free_bytes);
     if (available_bytes > 0) {
+        rx->len += available_bytes;
         return 0;
     } else if ((available_bytes < 0) && (errno == EAGAIN || errno == EWOULDBLOCK)) {
         // In case the read operation failed due to timeout, don't close the socket
@@ -123,6 +148,7 @@ int socket_thread::socket_disconnected_uds(Socket *sd)
     }
 
     // handle disconnection
+    clear_rx_buffer(sd);
     if (socket_disconnected(sd)) {
         sd->closeSocket();
         remove_socket(sd);
@@ -136,50 +162,84 @@ int socket_thread::socket_disconnected_uds(Socket *sd)
 
 bool socket_thread::handle_cmdu_message_uds(Socket *sd)
 {
-    size_t available_bytes;
-
-    // Check if UDS Header exists
-    available_bytes = sd->readBytes(rx_buffer, sizeof(rx_buffer), true, sizeof(message::sUdsHeader),
-                                    true); // PEEK UDS Header, blocking
-
-    if (available_bytes < sizeof(message::sUdsHeader)) {
-        THREAD_LOG(ERROR) << "available bytes = " << available_bytes
-                          << " is less then sizeof(sUdsHeader)=" << sizeof(message::sUdsHeader);
+    auto it = rx_buffers.find(sd);
+    if (it == rx_buffers.end()) {
+        THREAD_LOG(ERROR) << "no receive buffer for sd=" << intptr_t(sd);
         return false;
     }
 
-    // Header ready
-    message::sUdsHeader *uds_header = (message::sUdsHeader *)rx_buffer;
-    size_t message_size             = uds_header->length + sizeof(message::sUdsHeader);
+    // Keep the buffer alive in case the socket is removed by one of the handlers
+    auto rx = it->second;
+
+    bool ret      = true;
+    size_t offset = 0;
+    while (rx->len - offset >= sizeof(message::sUdsHeader)) {
+        auto uds_header     = reinterpret_cast<message::sUdsHeader *>(rx->buf() + offset);
+        size_t message_size = uds_header->length + sizeof(message::sUdsHeader);
+
+        if (message_size > message::MESSAGE_BUFFER_LENGTH_MAX) {
+            // the stream is out of sync, there is no way to find the next message
+            THREAD_LOG(ERROR) << "invalid message length=" << int(uds_header->length)
+                              << ", dropping " << rx->len - offset << " received bytes";
+            offset = rx->len;
+            ret    = false;
+            break;
+        }
 
-    // Try to read all message
-    available_bytes =
-        sd->readBytes(rx_buffer, sizeof(rx_buffer), true, message_size); // blocking read
+        if (rx->len - offset < message_size) {
+            // partial message, the rest of it will be read on the next event
+            break;
+        }
+        offset += message_size;
 
-    if (available_bytes != message_size) {
-        THREAD_LOG(ERROR) << "available bytes = " << available_bytes
-                          << " message_size = " << message_size;
-        return false;
-    }
+        if (!verify_cmdu(uds_header)) {
+            THREAD_LOG(ERROR) << "unable to verify cmdu!";
+            ret = false;
+            continue;
+        }
 
-    if (!verify_cmdu(uds_header)) {
-        THREAD_LOG(ERROR) << "unable to verify cmdu!";
-        return false;
+        if (!cmdu_rx.parse(reinterpret_cast<uint8_t *>(uds_header) + sizeof(message::sUdsHeader),
+                           uds_header->length, uds_header->swap_needed)) {
+            THREAD_LOG(ERROR) << "parsing cmdu failure, uds_header->length="
+                              << int(uds_header->length)
+                              << ", uds_header->swap_needed=" << int(uds_header->swap_needed);
+            ret = false;
+            continue;
+        }
+
+        if (!handle_cmdu(sd, cmdu_rx)) {
+            ret = false;
+        }
+
+        it = rx_buffers.find(sd);
+        if (it == rx_buffers.end() || it->second != rx) {
+            // the socket was removed, drop the rest of its messages
+            return ret;
+        }
     }
 
-    if (!cmdu_rx.parse(rx_buffer + sizeof(message::sUdsHeader), uds_header->length,
-                       uds_header->swap_needed)) {
-        THREAD_LOG(ERROR) << "parsing cmdu failure, rx_buffer" << std::hex << rx_buffer << std::dec
-                          << ", uds_header->length=" << int(uds_header->length)
-                          << ", uds_header->swap_needed=" << int(uds_header->swap_needed);
-        return false;
+    // Move the partial message (if any) to the start of the buffer
+    if (offset > 0) {
+        rx->len -= offset;
+        std::memmove(rx->buf(), rx->buf() + offset, rx->len);
     }
 
-    if (!handle_cmdu(sd, cmdu_rx)) {
-        return false;
+    // A message longer than the socket buffer is received in a buffer borrowed from the pool,
+    // which is given back once the pending message fits the socket buffer again
+    size_t pending_size = rx->len;
+    if (rx->len >= sizeof(message::sUdsHeader)) {
+        auto uds_header = reinterpret_cast<message::sUdsHeader *>(rx->buf());
+        pending_size    = uds_header->length + sizeof(message::sUdsHeader);
+    }
+    if (pending_size > rx->data.size() && !rx->large) {
+        rx->large = message_buffer_pool::get();
+        std::copy_n(rx->data.data(), rx->len, rx->large->data());
+    } else if (pending_size <= rx->data.size() && rx->large) {
+        std::copy_n(rx->large->data(), rx->len, rx->data.data());
+        rx->large.reset();
     }
 
-    return true;
+    return ret;
 }
 
 // FIXME - WLANRTSYS-6360 - should be moved to transport
@@ -294,33 +354,18 @@ bool socket_thread::work()
         }
     }
 
-    int sockets_count;
-    int i = 0;
-    do {
-        sockets_count = select.count();
-        for (i = 0; i < sockets_count; i++) {
-            if (read_ready(select.at(i))) {
-                Socket *sd = select.at(i);
-                if (!sd) {
-                    THREAD_LOG(WARNING)
-                        << "sd at select with index i=" << int(i) << " is nullptr, skipping";
-                    continue;
-                }
-
-                auto ret = socket_disconnected_uds(
-                    sd); // '0' - socket not disconnected (bytes to read), '1' - socket disconnected, '-1' - error
-                if (ret != 0) {
-                    // breaking instead of continue because socket_disconnected_uds() may erase element from Select Socket Vector while iterating it
-                    break;
-                }
-
-                if (!handle_cmdu_message_uds(sd)) {
-                    continue;
-                }
-            }
+    // Dispatch only the sockets which are ready. Sockets handled by the derived thread in
+    // after_select() are cleared from the ready list, and so are sockets removed while handling
+    // a disconnection.
+    Socket *sd;
+    while ((sd = select.nextReady()) != nullptr) {
+        auto ret = socket_disconnected_uds(
+            sd); // '0' - socket not disconnected (bytes to read), '1' - socket disconnected, '-1' - error
+        if (ret != 0) {
+            continue;
         }
-        // The loop should go over all the sockets. In case something break the for loop before it ended,
-        // start iterating over the sockets again.
-    } while (i < sockets_count);
+
+        handle_cmdu_message_uds(sd);
+    }
     return true;
 }
@@ -108,6 +108,10 @@ uint64_t network_utils::mac_to_uint64(const uint8_t *mac_address)
     mac = (uint64_t(mac_address[0]) << 16) | (uint64_t(mac_address[1]) << 24) |
           (uint64_t(mac_address[2]) << 32) | (uint64_t(mac_address[3]) << 40) |
           (uint64_t(mac_address[4]) << 48) | (uint64_t(mac_address[5]) << 56);
+#else
+    mac = (uint64_t(mac_address[0]) << 40) | (uint64_t(mac_address[1]) << 32) |
+          (uint64_t(mac_address[2]) << 24) | (uint64_t(mac_address[3]) << 16) |
+          (uint64_t(mac_address[4]) << 8) | uint64_t(mac_address[5]);
 #endif
 
     return (mac);
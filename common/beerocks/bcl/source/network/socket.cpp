@@ -8,6 +8,7 @@
 
 #include "../../include/beerocks/bcl/network/socket.h"
 
+#include <algorithm>
 #include <errno.h>
 
 #ifdef IS_WINDOWS
@@ -222,6 +223,7 @@ ssize_t Socket::writeBytes(const uint8_t *buf, size_t buf_len, int port, struct
         int flags = MSG_NOSIGNAL;
 #endif
 
+        std::lock_guard<std::mutex> lock(m_write_mutex);
         return send(m_socket, (const char *)buf, (int)buf_len, flags);
     }
 }
@@ -463,10 +465,24 @@ SocketClient::SocketClient(const std::string &host, int port, int connect_timeou
 #endif
 }
 
-SocketSelect::SocketSelect()
+SocketSelect::SocketSelect(eBackend backend)
 {
     m_socketTval = NULL;
     m_isBlocking = true;
+    m_backend    = backend;
+    FD_ZERO(&m_socketSet);
+
+#ifndef IS_WINDOWS
+    if (m_backend == BACKEND_EPOLL) {
+        m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (m_epoll_fd < 0) {
+            m_error   = std::string("epoll_create1() failed: ") + strerror(errno);
+            m_backend = BACKEND_SELECT;
+        }
+    }
+#else
+    m_backend = BACKEND_SELECT;
+#endif
 }
 
 SocketSelect::~SocketSelect()
@@ -477,6 +493,13 @@ SocketSelect::~SocketSelect()
         }
     }
     m_socketVec.clear();
+    m_readyVec.clear();
+
+#ifndef IS_WINDOWS
+    if (m_epoll_fd >= 0) {
+        close(m_epoll_fd);
+    }
+#endif
 }
 
 void SocketSelect::setTimeout(timeval *tval)
@@ -509,6 +532,19 @@ void SocketSelect::addSocket(Socket *s)
         }
     }
 
+#ifndef IS_WINDOWS
+    if (m_backend == BACKEND_EPOLL) {
+        // Level triggered, since a ready socket is not necessarily drained by its handler
+        struct epoll_event event = {};
+        event.events             = EPOLLIN;
+        event.data.ptr           = s;
+        if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, s->m_socket, &event) < 0) {
+            m_error = std::string("epoll_ctl(EPOLL_CTL_ADD) failed: ") + strerror(errno);
+            return;
+        }
+    }
+#endif
+
     m_socketVec.push_back(s);
 }
 
@@ -525,18 +561,50 @@ void SocketSelect::removeSocket(Socket *s)
         if (i < m_socketVec.size()) {
             m_socketVec.erase(m_socketVec.begin() + i);
         }
+
+#ifndef IS_WINDOWS
+        // A closed socket was already removed from the epoll set by the kernel
+        if (m_backend == BACKEND_EPOLL && s->m_socket != INVALID_SOCKET) {
+            epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, s->m_socket, nullptr);
+        }
+#endif
+
+        // The socket may be deleted by the caller, so it must not be reported as ready
+        clearReady(s);
     }
 }
 
 void SocketSelect::clearReady(Socket *s)
 {
     if (s) {
-        FD_CLR(s->m_socket, &m_socketSet);
+        if (m_backend == BACKEND_SELECT && s->m_socket != INVALID_SOCKET) {
+            FD_CLR(s->m_socket, &m_socketSet);
+        }
+        m_readyVec.erase(std::remove(m_readyVec.begin(), m_readyVec.end(), s), m_readyVec.end());
     }
 }
 
 int SocketSelect::selectSocket()
 {
+    m_readyVec.clear();
+
+#ifndef IS_WINDOWS
+    if (m_backend == BACKEND_EPOLL) {
+        int timeout_ms = -1;
+        if (m_socketTval) {
+            timeout_ms = m_socketTval->tv_sec * 1000 + m_socketTval->tv_usec / 1000;
+        }
+
+        m_epoll_events.resize(std::max(m_socketVec.size(), size_t(1)));
+        int nready = epoll_wait(m_epoll_fd, m_epoll_events.data(), m_epoll_events.size(),
+                                timeout_ms);
+        for (int i = 0; i < nready; i++) {
+            m_readyVec.push_back(static_cast<Socket *>(m_epoll_events[i].data.ptr));
+        }
+        return nready;
+    }
+#endif
+
     int max_s = 0;
     FD_ZERO(&m_socketSet);
     for (unsigned i = 0; i < m_socketVec.size(); i++) {
@@ -553,7 +621,15 @@ int SocketSelect::selectSocket()
     } else {
         p_timeout = nullptr;
     }
-    return select(max_s + 1, &m_socketSet, (fd_set *)0, (fd_set *)0, p_timeout);
+    int nready = select(max_s + 1, &m_socketSet, (fd_set *)0, (fd_set *)0, p_timeout);
+    if (nready > 0) {
+        for (auto s : m_socketVec) {
+            if (FD_ISSET(s->m_socket, &m_socketSet)) {
+                m_readyVec.push_back(s);
+            }
+        }
+    }
+    return nready;
 }
 
 Socket *SocketSelect::at(size_t idx)
@@ -568,6 +644,10 @@ Socket *SocketSelect::at(size_t idx)
 bool SocketSelect::readReady(const Socket *s)
 {
     if ((s != nullptr) && (s->m_socket != INVALID_SOCKET)) {
+        if (m_backend == BACKEND_EPOLL) {
+            // fd_set can't hold fds above FD_SETSIZE, so look the socket up in the ready list
+            return std::find(m_readyVec.begin(), m_readyVec.end(), s) != m_readyVec.end();
+        }
         return (FD_ISSET(s->m_socket, &m_socketSet)) ? true : false;
     } else {
         return false;
@@ -583,6 +663,17 @@ bool SocketSelect::readReady(size_t idx)
     }
 }
 
+Socket *SocketSelect::nextReady()
+{
+    if (m_readyVec.empty()) {
+        return nullptr;
+    }
+
+    auto s = m_readyVec.front();
+    clearReady(s);
+    return s;
+}
+
 #ifndef IS_WINDOWS
 size_t Socket::getBytesWritePending()
 {
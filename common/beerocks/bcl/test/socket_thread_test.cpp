@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <beerocks/bcl/beerocks_socket_thread.h>
+
+#include <tlvf/ieee_1905_1/cCmduHeader.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+using namespace beerocks;
+
+class test_socket_thread : public socket_thread {
+public:
+    using socket_thread::add_socket;
+    using socket_thread::remove_socket;
+
+    std::vector<Socket *> received;
+
+protected:
+    virtual bool handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx) override
+    {
+        received.push_back(sd);
+        return true;
+    }
+    virtual bool socket_disconnected(Socket *sd) override { return false; }
+};
+
+// A message with an empty CMDU (header and end of message TLV)
+static std::vector<uint8_t> make_message()
+{
+    std::vector<uint8_t> msg(sizeof(message::sUdsHeader) +
+                             ieee1905_1::cCmduHeader::get_initial_size() + 3);
+    auto uds_header    = reinterpret_cast<message::sUdsHeader *>(msg.data());
+    uds_header->length = msg.size() - sizeof(message::sUdsHeader);
+    return msg;
+}
+
+// Bytes of a message which is received partially, its length covers more than them
+static std::vector<uint8_t> make_partial_message()
+{
+    std::vector<uint8_t> msg = make_message();
+    auto uds_header          = reinterpret_cast<message::sUdsHeader *>(msg.data());
+    uds_header->length += 100;
+    return msg;
+}
+
+static bool send_bytes(int fd, const std::vector<uint8_t> &bytes)
+{
+    return write(fd, bytes.data(), bytes.size()) == ssize_t(bytes.size());
+}
+
+// A socket removed while holding a partial message, and replaced by a new socket at the same
+// address, must not inherit the received bytes
+bool test_remove_and_readd_socket()
+{
+    std::cout << "START test_remove_and_readd_socket" << std::endl;
+    test_socket_thread thread;
+    thread.set_select_timeout(100);
+    bool ok = true;
+
+    // construct both sockets in the same storage
+    std::aligned_storage<sizeof(Socket), alignof(Socket)>::type storage;
+
+    int fds[2];
+    ok &= socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0;
+    auto sd1 = new (&storage) Socket(fds[0]);
+    thread.add_socket(sd1);
+    ok &= send_bytes(fds[1], make_partial_message());
+    ok &= thread.work() && thread.received.empty();
+
+    thread.remove_socket(sd1);
+    sd1->~Socket();
+    close(fds[0]);
+    close(fds[1]);
+
+    ok &= socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0;
+    auto sd2 = new (&storage) Socket(fds[0]);
+    ok &= static_cast<void *>(sd1) == static_cast<void *>(sd2);
+    thread.add_socket(sd2);
+    ok &= send_bytes(fds[1], make_message());
+    ok &= thread.work();
+    ok &= thread.received.size() == 1 && thread.received[0] == sd2;
+
+    thread.remove_socket(sd2);
+    sd2->~Socket();
+    close(fds[0]);
+    close(fds[1]);
+
+    std::cout << "END test_remove_and_readd_socket " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main()
+{
+    if (!test_remove_and_readd_socket()) {
+        return 1;
+    }
+    return 0;
+}
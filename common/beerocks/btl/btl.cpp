@@ -10,6 +10,10 @@
 
 #include <beerocks/bcl/network/network_utils.h>
 #include <easylogging++.h>
+#ifndef UDS_BUS
+// complete type of bus_rx_msg for the constructor and the destructor
+#include <mapf/common/message.h>
+#endif
 
 using namespace beerocks::btl;
 using namespace beerocks::net;
@@ -20,6 +20,7 @@ namespace mapf {
 class Poller;
 class LocalBusInterface;
 class SubSocket;
+class Message;
 } // namespace mapf
 
 namespace beerocks {
@@ -65,6 +66,8 @@ private:
 #else
     std::shared_ptr<mapf::LocalBusInterface> bus = nullptr;
     std::shared_ptr<mapf::Poller> poller         = nullptr;
+    // last message received from the bus, cmdu_rx points into its frame
+    std::unique_ptr<mapf::Message> bus_rx_msg;
 #endif
 };
 } // namespace btl
@@ -70,6 +70,9 @@ void transport_socket_thread::bus_init()
 
     poller = std::make_shared<mapf::Poller>();
     LOG_IF(!poller, FATAL) << "Failed allocating Poller!";
+
+    // CMDUs published on the bus are built on the stack and never modified after being sent
+    bus->publisher().SetZeroCopy(true);
 }
 
 bool transport_socket_thread::bus_subscribe(const std::vector<ieee1905_1::eMessageType> &msg_types)
@@ -145,6 +148,7 @@ void transport_socket_thread::remove_socket(Socket *s)
     LOG_IF(!poller, FATAL) << "Poller is not allocated!";
 
     poller->Remove(s->getSocketFd());
+    clear_rx_buffer(s);
     sockets.erase(std::remove(sockets.begin(), sockets.end(), s), sockets.end());
 }
 
@@ -168,37 +172,47 @@ bool transport_socket_thread::read_ready(Socket *s)
 
 bool transport_socket_thread::handle_cmdu_message_bus()
 {
-    auto msg = bus->subscriber().Receive();
-    if (msg == nullptr) {
+    // The CMDU is parsed in place on top of the received message frame (instead of being copied
+    // to a receive buffer), so the message is kept alive until the next one is received.
+    // The message object itself is reused for the next message.
+    if (!bus->subscriber().Receive(bus_rx_msg) || bus_rx_msg == nullptr) {
         THREAD_LOG(ERROR) << "Received msg is null";
         return false;
     }
 
-    auto cmdu_rx_msg = dynamic_cast<mapf::CmduRxMessage *>(msg.get());
+    auto cmdu_rx_msg = dynamic_cast<mapf::CmduRxMessage *>(bus_rx_msg.get());
     if (cmdu_rx_msg) {
     } else {
-        THREAD_LOG(ERROR) << "received non CmduRxMessage:\n\tMessage: " << *msg
-                          << "\n\tFrame: " << msg->frame().str();
+        THREAD_LOG(ERROR) << "received non CmduRxMessage:\n\tMessage: " << *bus_rx_msg
+                          << "\n\tFrame: " << bus_rx_msg->frame().str();
         return false;
     }
 
-    // Copy the data to rx_buffer
-    if (sizeof(message::sUdsHeader) + cmdu_rx_msg->metadata()->length > sizeof(rx_buffer)) {
-        THREAD_LOG(ERROR)
-            << "sizeof(message::sUdsHeader) + cmdu_rx_msg->metadata()->length > sizeof(rx_buffer)";
+    auto metadata   = cmdu_rx_msg->metadata();
+    uint16_t length = metadata->length;
+    if (cmdu_rx_msg->frames().back().len() < sizeof(mapf::CmduRxMessage::Metadata) + length) {
+        THREAD_LOG(ERROR) << "frame length " << cmdu_rx_msg->frames().back().len()
+                          << " is too short for cmdu length " << length;
         return false;
     }
 
-    std::copy_n((uint8_t *)cmdu_rx_msg->data(), cmdu_rx_msg->metadata()->length,
-                rx_buffer + sizeof(message::sUdsHeader));
+    // The metadata is not needed beyond this point, so the UDS header (which users of cmdu_rx
+    // expect to find right before the CMDU) is written over its tail.
+    static_assert(sizeof(mapf::CmduRxMessage::Metadata) >= sizeof(message::sUdsHeader),
+                  "metadata is too small to hold the UDS header");
+    uint8_t src_bridge_mac[sizeof(mapf::CmduRxMessage::Metadata::src)];
+    uint8_t dst_bridge_mac[sizeof(mapf::CmduRxMessage::Metadata::dst)];
+    std::copy_n(metadata->src, sizeof(src_bridge_mac), src_bridge_mac);
+    std::copy_n(metadata->dst, sizeof(dst_bridge_mac), dst_bridge_mac);
+
+    uint8_t *cmdu_buffer = cmdu_rx_msg->data();
+    message::sUdsHeader *uds_header =
+        (message::sUdsHeader *)(cmdu_buffer - sizeof(message::sUdsHeader));
 
     // fill UDS Header
-    message::sUdsHeader *uds_header = (message::sUdsHeader *)rx_buffer;
-    std::copy_n((uint8_t *)cmdu_rx_msg->metadata()->src, sizeof(mapf::CmduRxMessage::Metadata::src),
-                uds_header->src_bridge_mac);
-    std::copy_n((uint8_t *)cmdu_rx_msg->metadata()->dst, sizeof(mapf::CmduRxMessage::Metadata::dst),
-                uds_header->dst_bridge_mac);
-    uds_header->length      = cmdu_rx_msg->metadata()->length;
+    std::copy_n(src_bridge_mac, sizeof(src_bridge_mac), uds_header->src_bridge_mac);
+    std::copy_n(dst_bridge_mac, sizeof(dst_bridge_mac), uds_header->dst_bridge_mac);
+    uds_header->length      = length;
     uds_header->swap_needed = true;
 
     if (!verify_cmdu(uds_header)) {
@@ -206,10 +220,9 @@ bool transport_socket_thread::handle_cmdu_message_bus()
         return false;
     }
 
-    if (!cmdu_rx.parse(rx_buffer + sizeof(message::sUdsHeader), uds_header->length,
-                       uds_header->swap_needed)) {
-        THREAD_LOG(ERROR) << "parsing cmdu failure, rx_buffer" << std::hex << rx_buffer << std::dec
-                          << ", uds_header->length=" << int(uds_header->length)
+    if (!cmdu_rx.parse(cmdu_buffer, uds_header->length, uds_header->swap_needed)) {
+        THREAD_LOG(ERROR) << "parsing cmdu failure, cmdu_buffer" << std::hex << cmdu_buffer
+                          << std::dec << ", uds_header->length=" << int(uds_header->length)
                           << ", uds_header->swap_needed=" << int(uds_header->swap_needed);
         return false;
     }
@@ -224,13 +237,12 @@ bool transport_socket_thread::handle_cmdu_message_bus()
 bool transport_socket_thread::bus_send(ieee1905_1::CmduMessage &cmdu, const std::string &dst_mac,
                                        const std::string &src_mac, uint16_t length)
 {
-    mapf::CmduTxMessage msg;
+    mapf::CmduTxMessage msg(length);
 
     net::network_utils::mac_from_string(msg.metadata()->src, src_mac);
     net::network_utils::mac_from_string(msg.metadata()->dst, dst_mac);
 
     msg.metadata()->ether_type        = ETH_P_1905_1;
-    msg.metadata()->length            = length;
     msg.metadata()->msg_type          = static_cast<uint16_t>(cmdu.getMessageType());
     msg.metadata()->preset_message_id = cmdu.getMessageId() ? 1 : 0;
 
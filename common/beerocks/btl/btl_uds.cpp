@@ -140,42 +140,25 @@ bool transport_socket_thread::work()
         }
     }
 
-    int sockets_count;
-    int i = 0;
-    do {
-        sockets_count = select.count();
-        for (i = 0; i < sockets_count; i++) {
-            if (read_ready(select.at(i))) {
-                Socket *sd = select.at(i);
-                if (!sd) {
-                    THREAD_LOG(WARNING)
-                        << "sd at select with index i=" << int(i) << " is nullptr, skipping";
-                    continue;
-                }
-
-                bool bus_socket_event = (sd == bus);
-
-                auto ret = socket_disconnected_uds(
-                    sd); // '0' - socket not disconnected (bytes to read), '1' - socket disconnected, '-1' - error
-                if (ret == 1) {
-                    if (bus_socket_event) {
-                        THREAD_LOG(FATAL) << "setting bus to nullptr";
-                        bus = nullptr;
-                    }
-                    // breaking instead of continue because socket_disconnected_uds() may erase element from Select Socket Vector while iterating it
-                    break;
-                } else if (ret == -1) {
-                    continue;
-                }
-
-                if (!handle_cmdu_message_uds(sd)) {
-                    continue;
-                }
+    // Dispatch only the sockets which are ready
+    Socket *sd;
+    while ((sd = select.nextReady()) != nullptr) {
+        bool bus_socket_event = (sd == bus);
+
+        auto ret = socket_disconnected_uds(
+            sd); // '0' - socket not disconnected (bytes to read), '1' - socket disconnected, '-1' - error
+        if (ret == 1) {
+            if (bus_socket_event) {
+                THREAD_LOG(FATAL) << "setting bus to nullptr";
+                bus = nullptr;
             }
+            continue;
+        } else if (ret == -1) {
+            continue;
         }
-        // The loop should go over all the sockets. In case something break the for loop before it ended,
-        // start iterating over the sockets again.
-    } while (i < sockets_count);
+
+        handle_cmdu_message_uds(sd);
+    }
 
     return true;
-}
\ No newline at end of file
+}
@@ -27,13 +27,6 @@ using namespace beerocks;
 namespace bwl {
 namespace brcm {
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////////////// Implementation ///////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -360,7 +353,7 @@ bool ap_wlan_hal_brcm::process_ext_events()
             LOG(DEBUG) << "STA Connected: " << mac;
 
             // TODO: Change to HAL objects
-            auto msg_buff = ALLOC_SMART_BUFFER(
+            auto msg_buff = alloc_event_buffer(
                 sizeof(beerocks::message::sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
             auto msg = reinterpret_cast<
                 beerocks::message::sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION *>(
@@ -389,7 +382,7 @@ bool ap_wlan_hal_brcm::process_ext_events()
 
             LOG(DEBUG) << "STA Disconnected: " << sta->first;
 
-            auto msg_buff = ALLOC_SMART_BUFFER(
+            auto msg_buff = alloc_event_buffer(
                 sizeof(beerocks::message::sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
             auto msg = reinterpret_cast<
                 beerocks::message::sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION *>(
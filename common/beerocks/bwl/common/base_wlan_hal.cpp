@@ -10,15 +10,107 @@
 
 #include <easylogging++.h>
 
-#include <errno.h>
-#include <sys/eventfd.h>
-#include <unistd.h>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <type_traits>
 
 // Use easylogging++ instance of the main application
 SHARE_EASYLOGGINGPP(el::Helpers::storage())
 
 namespace bwl {
 
+namespace {
+
+// Fixed size slots for the event objects, payloads and their shared_ptr control blocks,
+// which are allocated for every event by the HAL threads and released by the consumer.
+// Allocations that don't fit a slot, or made while the pool is exhausted, use the heap.
+class hal_event_pool {
+public:
+    static constexpr size_t SLOT_SIZE    = 128;
+    static constexpr size_t NUM_OF_SLOTS = 512;
+
+    hal_event_pool()
+    {
+        for (size_t i = 0; i < NUM_OF_SLOTS - 1; i++) {
+            m_slots[i].next = &m_slots[i + 1];
+        }
+        m_slots[NUM_OF_SLOTS - 1].next = nullptr;
+        m_free                         = &m_slots[0];
+    }
+
+    void *alloc(size_t size)
+    {
+        if (size <= SLOT_SIZE) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_free) {
+                auto slot = m_free;
+                m_free    = slot->next;
+                return slot;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void free(void *ptr)
+    {
+        // Heap allocations are not part of m_slots, the built-in pointer comparisons are
+        // unspecified for them while std::less is a total order
+        std::less<const void *> less;
+        if (less(ptr, &m_slots[0]) || !less(ptr, &m_slots[NUM_OF_SLOTS])) {
+            ::operator delete(ptr);
+            return;
+        }
+        auto slot = static_cast<sSlot *>(ptr);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        slot->next = m_free;
+        m_free     = slot;
+    }
+
+private:
+    union sSlot {
+        sSlot *next;
+        std::aligned_storage<SLOT_SIZE, alignof(std::max_align_t)>::type storage;
+    };
+
+    sSlot m_slots[NUM_OF_SLOTS];
+    sSlot *m_free = nullptr;
+    std::mutex m_mutex;
+};
+
+// Never destroyed, events may still be released by other threads while the process exits
+hal_event_pool &get_hal_event_pool()
+{
+    static auto pool = new hal_event_pool;
+    return *pool;
+}
+
+template <typename T> struct hal_event_allocator {
+    typedef T value_type;
+
+    hal_event_allocator() = default;
+    template <typename U> hal_event_allocator(const hal_event_allocator<U> &) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(get_hal_event_pool().alloc(n * sizeof(T))); }
+    void deallocate(T *ptr, size_t) { get_hal_event_pool().free(ptr); }
+};
+
+template <typename T, typename U>
+bool operator==(const hal_event_allocator<T> &, const hal_event_allocator<U> &)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const hal_event_allocator<T> &, const hal_event_allocator<U> &)
+{
+    return false;
+}
+
+} // namespace
+
 base_wlan_hal::base_wlan_hal(HALType type, std::string iface_name, IfaceType iface_type,
                              bool acs_enabled, hal_event_cb_t callback)
     : m_type(type), m_iface_name(iface_name), m_iface_type(iface_type), m_acs_enabled(acs_enabled),
@@ -30,58 +122,52 @@ base_wlan_hal::base_wlan_hal(HALType type, std::string iface_name, IfaceType ifa
     m_radio_info.iface_name  = iface_name;
     m_radio_info.iface_type  = iface_type;
     m_radio_info.acs_enabled = acs_enabled;
-    // Create an eventfd for internal events
-    if ((m_fd_int_events = eventfd(0, EFD_SEMAPHORE)) < 0) {
-        LOG(FATAL) << "Failed creating eventfd: " << strerror(errno);
+
+    // The internal events queue failed creating its eventfd
+    if (get_int_events_fd() < 0) {
+        LOG(FATAL) << "Failed creating eventfd for the internal events";
     }
 
     // Initialize complex containers of the radio_info structure
     m_radio_info.supported_channels.resize(128 /* TODO: Get real value */);
 }
 
-base_wlan_hal::~base_wlan_hal()
-{
-    // Close the eventfd used for internal events
-    if (m_fd_int_events != -1) {
-        close(m_fd_int_events);
-        m_fd_int_events = -1;
-    }
-}
+base_wlan_hal::~base_wlan_hal() {}
 
 bool base_wlan_hal::event_queue_push(int event, std::shared_ptr<void> data)
 {
     // Create a new shared pointer of the event and the payload
-    auto event_ptr = std::make_shared<hal_event_t>(hal_event_t(event, data));
+    auto event_ptr =
+        std::allocate_shared<hal_event_t>(hal_event_allocator<hal_event_t>(), event, data);
 
-    // Push the event into the queue
-    // push with block (default true) can't return false
-    m_queue_events.push(event_ptr);
-
-    // Increment the eventfd counter by 1
-    uint64_t counter = 1;
-    if (write(m_fd_int_events, &counter, sizeof(counter)) < 0) {
-        LOG(ERROR) << "Failed updating eventfd counter: " << strerror(errno);
+    // Push the event into the queue, which also signals the internal events fd.
+    // Don't block when the queue is full, the consumer thread may push events itself
+    if (!m_queue_events.push(event_ptr, false)) {
+        LOG(ERROR) << "Internal events queue is full, dropping event " << event;
         return false;
     }
 
     return true;
 }
 
-bool base_wlan_hal::process_int_events()
+std::shared_ptr<char> base_wlan_hal::alloc_event_buffer(size_t size)
 {
-    // Read the counter value of the eventfd
-    uint64_t counter = 0;
-    if (read(m_fd_int_events, &counter, sizeof(counter)) < 0) {
-        LOG(ERROR) << "Failed reading eventfd counter: " << strerror(errno);
-        return false;
-    }
+    auto buffer = static_cast<char *>(get_hal_event_pool().alloc(size));
+    memset(buffer, 0, size);
 
-    // Pop an event from the queue
+    // The control block is taken from the pool as well
+    return std::shared_ptr<char>(
+        buffer, [](char *obj) { get_hal_event_pool().free(obj); }, hal_event_allocator<char>());
+}
+
+bool base_wlan_hal::process_int_events()
+{
+    // Pop an event from the queue, the internal events fd remains readable while the queue
+    // is not empty
     auto event = m_queue_events.pop(false);
 
-    if (!event || !counter) {
-        LOG(WARNING) << "process_int_events() called by the event queue pointer is " << event
-                     << " and/or eventfd counter = " << counter;
+    if (!event) {
+        LOG(WARNING) << "process_int_events() called but the event queue is empty";
 
         return false;
     }
@@ -12,7 +12,7 @@
 #include "base_802_11_defs.h"
 #include "base_wlan_hal_types.h"
 
-#include <beerocks/bcl/beerocks_thread_safe_queue.h>
+#include <beerocks/bcl/beerocks_lockfree_queue.h>
 
 #include <functional>
 #include <memory>
@@ -125,7 +125,7 @@ public:
      * Returns a file descriptor to the internal events queue, or -1 on error.
      * The returned file descriptor supports select(), poll() and epoll().
      */
-    int get_int_events_fd() const { return (m_fd_int_events); }
+    int get_int_events_fd() const { return (m_queue_events.get_event_fd()); }
 
     /*!
      * Returns the interface name.
@@ -170,6 +170,17 @@ protected:
      */
     bool event_queue_push(int event, std::shared_ptr<void> data = {});
 
+    /*!
+     * Allocate a zeroed buffer for an event payload.
+     * Small buffers are taken from a pool of recycled slots (shared by all the HAL
+     * instances of the process) and returned to it when the last reference is released.
+     *
+     * @param [in] size Size of the buffer in bytes.
+     *
+     * @return Shared pointer to the buffer.
+     */
+    static std::shared_ptr<char> alloc_event_buffer(size_t size);
+
     // Protected methods:
 protected:
     /*!
@@ -195,11 +206,11 @@ private:
 
     bool m_acs_enabled;
 
-    int m_fd_int_events = -1;
-
     hal_event_cb_t m_int_event_cb;
 
-    beerocks::thread_safe_queue<hal_event_ptr_t> m_queue_events;
+    // Events are pushed by the HAL threads and popped by the thread which owns the HAL
+    static constexpr size_t INT_EVENTS_QUEUE_SIZE = 512;
+    beerocks::mpsc_queue<hal_event_ptr_t, INT_EVENTS_QUEUE_SIZE> m_queue_events;
 };
 
 } // namespace bwl
@@ -0,0 +1,189 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BWL_HAL_EVENT_PARSER_H_
+#define _BWL_HAL_EVENT_PARSER_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+
+namespace bwl {
+
+/*!
+ * FNV-1a hash of an event opcode.
+ * Evaluated at compile time for string literals, so opcodes can be dispatched with a
+ * switch on the hash of the received opcode instead of a chain of string comparisons.
+ * Two opcodes with the same hash fail the build on the duplicate case label.
+ *
+ * @param [in] opcode Null terminated event opcode.
+ *
+ * @return The hash of the opcode.
+ */
+constexpr uint32_t event_opcode_hash(const char *opcode, uint32_t hash = 2166136261u)
+{
+    return *opcode ? event_opcode_hash(opcode + 1, (hash ^ uint8_t(*opcode)) * 16777619u) : hash;
+}
+
+inline uint32_t event_opcode_hash(const std::string &opcode)
+{
+    return event_opcode_hash(opcode.c_str());
+}
+
+/*!
+ * Confirm the match of an opcode dispatched on its hash.
+ * An unknown opcode may share the hash of a known one, so the matching case
+ * compares the strings once.
+ *
+ * @param [in] opcode Received event opcode.
+ * @param [in] expected Opcode of the matching case.
+ * @param [in] event Event of the matching case.
+ *
+ * @return event if the opcodes are equal, or the Invalid event otherwise.
+ */
+template <typename E>
+inline E event_opcode_match(const std::string &opcode, const char *expected, E event)
+{
+    return (opcode == expected) ? event : E::Invalid;
+}
+
+/*!
+ * Case of a switch on event_opcode_hash(opcode), which returns event if the received
+ * opcode is literal or the Invalid event otherwise.
+ * Writes the opcode literal once for both the hash and the match.
+ */
+#define EVENT_OPCODE_CASE(opcode, literal, event)                                                  \
+    case ::bwl::event_opcode_hash(literal):                                                        \
+        return ::bwl::event_opcode_match(opcode, literal, event)
+
+/*!
+ * Zero-copy tokenizer of hostapd/wpa_supplicant event strings:
+ *
+ *     <3>OPCODE param param ... key=value key=value ...
+ *
+ * The keyless params are separated by single spaces. A value may contain spaces,
+ * it ends at the last space before the next '='.
+ * Tokens point into the event string, which must outlive the tokenizer.
+ */
+class event_tokenizer {
+public:
+    struct sToken {
+        const char *str = nullptr;
+        size_t len      = 0;
+
+        std::string to_string() const { return std::string(str, len); }
+    };
+
+    /*!
+     * Constructor.
+     *
+     * @param [in] event Event string, the log level prefix ("<3>") is skipped.
+     * @param [in] len Length of the event string.
+     */
+    event_tokenizer(const char *event, size_t len) : m_pos(event), m_end(event + len)
+    {
+        auto level_end = static_cast<const char *>(memchr(event, '>', len));
+        if (level_end) {
+            m_pos = level_end + 1;
+        }
+
+        // The keyless params end at the space before the first key
+        auto equal   = find(m_pos, '=');
+        m_params_end = (equal == m_end) ? m_end : rfind(m_pos, equal, ' ');
+    }
+
+    /*!
+     * Read the next keyless param, the first one is the event opcode.
+     *
+     * @param [out] param The param.
+     *
+     * @return false when there are no more keyless params.
+     */
+    bool next_param(sToken &param)
+    {
+        if (m_pos >= m_params_end) {
+            return false;
+        }
+
+        auto space = find(m_pos, ' ');
+        if (space > m_params_end) {
+            space = m_params_end;
+        }
+        param.str = m_pos;
+        param.len = space - m_pos;
+        m_pos     = space + 1;
+        return true;
+    }
+
+    /*!
+     * Read the next key=value pair, the remaining keyless params are skipped.
+     *
+     * @param [out] key The key.
+     * @param [out] value The value, empty if the key has none.
+     *
+     * @return false when there are no more pairs.
+     */
+    bool next_pair(sToken &key, sToken &value)
+    {
+        if (m_pos < m_params_end) {
+            m_pos = m_params_end;
+        }
+
+        while (m_pos < m_end && *m_pos == ' ') {
+            m_pos++;
+        }
+        if (m_pos >= m_end) {
+            return false;
+        }
+
+        // The pair ends at the last space before the next key
+        auto equal      = find(m_pos, '=');
+        auto next_equal = (equal == m_end) ? m_end : find(equal + 1, '=');
+        auto pair_end   = (next_equal == m_end) ? m_end : rfind(equal + 1, next_equal, ' ');
+
+        key.str   = m_pos;
+        key.len   = equal - m_pos;
+        value.str = (equal == m_end) ? m_end : equal + 1;
+        value.len = (value.str < pair_end) ? pair_end - value.str : 0;
+        m_pos     = pair_end;
+
+        // Skip the remains of a malformed pair ("key=value=value")
+        if (!key.len) {
+            return next_pair(key, value);
+        }
+
+        return true;
+    }
+
+private:
+    const char *find(const char *from, char c) const
+    {
+        auto found = static_cast<const char *>(memchr(from, c, m_end - from));
+        return found ? found : m_end;
+    }
+
+    // Last occurrence of c in [from, to), or to if there is none
+    const char *rfind(const char *from, const char *to, char c) const
+    {
+        for (auto it = to; it > from; it--) {
+            if (*(it - 1) == c) {
+                return it - 1;
+            }
+        }
+        return to;
+    }
+
+    const char *m_pos;
+    const char *m_end;
+    const char *m_params_end;
+};
+
+} // namespace bwl
+
+#endif // _BWL_HAL_EVENT_PARSER_H_
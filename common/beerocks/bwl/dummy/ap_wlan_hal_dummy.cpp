@@ -31,13 +31,6 @@ namespace dummy {
 #define WLAN_FC_STYPE_PROBE_REQ 4
 #define WLAN_FC_STYPE_AUTH 11
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 // Temporary storage for station capabilities
 struct SRadioCapabilitiesStrings {
     std::string supported_rates;
@@ -7,6 +7,7 @@
  */
 
 #include "ap_wlan_hal_dwpal.h"
+#include "../common/hal_event_parser.h"
 
 #include <beerocks/bcl/beerocks_defines.h>
 #include <beerocks/bcl/beerocks_os_utils.h>
@@ -34,13 +35,6 @@ namespace dwpal {
 #define WLAN_FC_STYPE_PROBE_REQ 4
 #define WLAN_FC_STYPE_AUTH 11
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 // Temporary storage for station capabilities
 struct SRadioCapabilitiesStrings {
     std::string supported_rates;
@@ -65,36 +59,22 @@ struct DWPAL_acs_report_get {
 
 static ap_wlan_hal::Event dwpal_to_bwl_event(const std::string &opcode)
 {
-    if (opcode == "AP-ENABLED") {
-        return ap_wlan_hal::Event::AP_Enabled;
-    } else if (opcode == "AP-DISABLED") {
-        return ap_wlan_hal::Event::AP_Disabled;
-    } else if (opcode == "AP-STA-CONNECTED") {
-        return ap_wlan_hal::Event::STA_Connected;
-    } else if (opcode == "AP-STA-DISCONNECTED") {
-        return ap_wlan_hal::Event::STA_Disconnected;
-    } else if (opcode == "UNCONNECTED-STA-RSSI") {
-        return ap_wlan_hal::Event::STA_Unassoc_RSSI;
-    } else if (opcode == "INTERFACE-ENABLED") {
-        return ap_wlan_hal::Event::Interface_Enabled;
-    } else if (opcode == "INTERFACE-DISABLED") {
-        return ap_wlan_hal::Event::Interface_Disabled;
-    } else if (opcode == "ACS-STARTED") {
-        return ap_wlan_hal::Event::ACS_Started;
-    } else if (opcode == "ACS-COMPLETED") {
-        return ap_wlan_hal::Event::ACS_Completed;
-    } else if (opcode == "ACS-FAILED") {
-        return ap_wlan_hal::Event::ACS_Failed;
-    } else if (opcode == "AP-CSA-FINISHED") {
-        return ap_wlan_hal::Event::CSA_Finished;
-    } else if (opcode == "BSS-TM-RESP") {
-        return ap_wlan_hal::Event::BSS_TM_Response;
-    } else if (opcode == "DFS-CAC-COMPLETED") {
-        return ap_wlan_hal::Event::DFS_CAC_Completed;
-    } else if (opcode == "DFS-NOP-FINISHED") {
-        return ap_wlan_hal::Event::DFS_NOP_Finished;
-    } else if (opcode == "LTQ-SOFTBLOCK-DROP") {
-        return ap_wlan_hal::Event::STA_Softblock_Drop;
+    switch (event_opcode_hash(opcode)) {
+        EVENT_OPCODE_CASE(opcode, "AP-ENABLED", ap_wlan_hal::Event::AP_Enabled);
+        EVENT_OPCODE_CASE(opcode, "AP-DISABLED", ap_wlan_hal::Event::AP_Disabled);
+        EVENT_OPCODE_CASE(opcode, "AP-STA-CONNECTED", ap_wlan_hal::Event::STA_Connected);
+        EVENT_OPCODE_CASE(opcode, "AP-STA-DISCONNECTED", ap_wlan_hal::Event::STA_Disconnected);
+        EVENT_OPCODE_CASE(opcode, "UNCONNECTED-STA-RSSI", ap_wlan_hal::Event::STA_Unassoc_RSSI);
+        EVENT_OPCODE_CASE(opcode, "INTERFACE-ENABLED", ap_wlan_hal::Event::Interface_Enabled);
+        EVENT_OPCODE_CASE(opcode, "INTERFACE-DISABLED", ap_wlan_hal::Event::Interface_Disabled);
+        EVENT_OPCODE_CASE(opcode, "ACS-STARTED", ap_wlan_hal::Event::ACS_Started);
+        EVENT_OPCODE_CASE(opcode, "ACS-COMPLETED", ap_wlan_hal::Event::ACS_Completed);
+        EVENT_OPCODE_CASE(opcode, "ACS-FAILED", ap_wlan_hal::Event::ACS_Failed);
+        EVENT_OPCODE_CASE(opcode, "AP-CSA-FINISHED", ap_wlan_hal::Event::CSA_Finished);
+        EVENT_OPCODE_CASE(opcode, "BSS-TM-RESP", ap_wlan_hal::Event::BSS_TM_Response);
+        EVENT_OPCODE_CASE(opcode, "DFS-CAC-COMPLETED", ap_wlan_hal::Event::DFS_CAC_Completed);
+        EVENT_OPCODE_CASE(opcode, "DFS-NOP-FINISHED", ap_wlan_hal::Event::DFS_NOP_Finished);
+        EVENT_OPCODE_CASE(opcode, "LTQ-SOFTBLOCK-DROP", ap_wlan_hal::Event::STA_Softblock_Drop);
     }
 
     return ap_wlan_hal::Event::Invalid;
@@ -1022,7 +1002,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
         LOG(DEBUG) << "AP-STA-CONNECTED buffer= \n" << buffer;
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1143,7 +1123,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
         LOG(DEBUG) << "AP-STA-DISCONNECTED buffer= \n" << buffer;
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1197,7 +1177,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
         LOG(DEBUG) << "UNCONNECTED-STA-RSSI buffer= \n" << buffer;
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
         auto msg = reinterpret_cast<sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1329,7 +1309,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
         if (message_type == WLAN_FC_STYPE_PROBE_REQ) {
 
             auto msg_buff =
-                ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_STEERING_EVENT_PROBE_REQ_NOTIFICATION));
+                alloc_event_buffer(sizeof(sACTION_APMANAGER_STEERING_EVENT_PROBE_REQ_NOTIFICATION));
             auto msg = reinterpret_cast<sACTION_APMANAGER_STEERING_EVENT_PROBE_REQ_NOTIFICATION *>(
                 msg_buff.get());
             LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1401,7 +1381,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
         } else if (message_type == WLAN_FC_STYPE_AUTH) {
 
             auto msg_buff =
-                ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_STEERING_EVENT_AUTH_FAIL_NOTIFICATION));
+                alloc_event_buffer(sizeof(sACTION_APMANAGER_STEERING_EVENT_AUTH_FAIL_NOTIFICATION));
             auto msg = reinterpret_cast<sACTION_APMANAGER_STEERING_EVENT_AUTH_FAIL_NOTIFICATION *>(
                 msg_buff.get());
             LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1491,7 +1471,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
     case Event::BSS_TM_Response: {
         LOG(DEBUG) << "BSS-TM-RESP buffer= \n" << buffer;
         // TODO: Change to HAL objects
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
+        auto msg_buff = alloc_event_buffer(sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
         auto msg = reinterpret_cast<sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
         // Initialize the message
@@ -1542,7 +1522,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION));
         auto msg = reinterpret_cast<sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1595,7 +1575,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
         LOG(DEBUG) << "DFS-NOP-FINISHED buffer= \n" << buffer;
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION));
         auto msg = reinterpret_cast<sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1644,7 +1624,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
     }
 
     case Event::AP_Disabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
+        auto msg_buff = alloc_event_buffer(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
         auto msg      = reinterpret_cast<sHOSTAP_DISABLED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
@@ -1672,7 +1652,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
     } break;
     case Event::AP_Enabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_ENABLED_NOTIFICATION));
+        auto msg_buff = alloc_event_buffer(sizeof(sHOSTAP_ENABLED_NOTIFICATION));
         auto msg      = reinterpret_cast<sHOSTAP_ENABLED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
@@ -7,6 +7,7 @@
  */
 
 #include "mon_wlan_hal_dwpal.h"
+#include "../common/hal_event_parser.h"
 
 #include <beerocks/bcl/beerocks_utils.h>
 #include <beerocks/bcl/network/network_utils.h>
@@ -33,31 +34,23 @@ namespace dwpal {
 #define GET_OP_CLASS(channel) ((channel < 14) ? 4 : 5)
 #define BUFFER_SIZE 4096
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////////// Local Module Functions ///////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
 static mon_wlan_hal::Event dwpal_to_bwl_event(const std::string &opcode)
 {
-    if (opcode == "RRM-CHANNEL-LOAD-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Channel_Load_Response;
-    } else if (opcode == "RRM-BEACON-REP-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Beacon_Response;
-    } else if (opcode == "RRM-STA-STATISTICS-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_STA_Statistics_Response;
-    } else if (opcode == "RRM-LINK-MEASUREMENT-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Link_Measurement_Response;
-    } else if (opcode == "AP-ENABLED") {
-        return mon_wlan_hal::Event::AP_Enabled;
-    } else if (opcode == "AP-DISABLED") {
-        return mon_wlan_hal::Event::AP_Disabled;
+    switch (event_opcode_hash(opcode)) {
+        EVENT_OPCODE_CASE(opcode, "RRM-CHANNEL-LOAD-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Channel_Load_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-BEACON-REP-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Beacon_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-STA-STATISTICS-RECEIVED",
+                          mon_wlan_hal::Event::RRM_STA_Statistics_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-LINK-MEASUREMENT-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Link_Measurement_Response);
+        EVENT_OPCODE_CASE(opcode, "AP-ENABLED", mon_wlan_hal::Event::AP_Enabled);
+        EVENT_OPCODE_CASE(opcode, "AP-DISABLED", mon_wlan_hal::Event::AP_Disabled);
     }
 
     return mon_wlan_hal::Event::Invalid;
@@ -417,7 +410,7 @@ bool mon_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
     case Event::RRM_Beacon_Response: {
         LOG(DEBUG) << "RRM-BEACON-REP-RECEIVED buffer= \n" << buffer;
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SBeaconResponse11k));
+        auto resp_buff = alloc_event_buffer(sizeof(SBeaconResponse11k));
         auto resp      = reinterpret_cast<SBeaconResponse11k *>(resp_buff.get());
 
         if (!resp) {
@@ -484,7 +477,7 @@ bool mon_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
     }
 
     case Event::AP_Enabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_ENABLED_NOTIFICATION));
+        auto msg_buff = alloc_event_buffer(sizeof(sHOSTAP_ENABLED_NOTIFICATION));
         if (!msg_buff) {
             LOG(FATAL) << "Memory allocation failed!";
             return false;
@@ -525,7 +518,7 @@ bool mon_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
     }
 
     case Event::AP_Disabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
+        auto msg_buff = alloc_event_buffer(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
         if (!msg_buff) {
             LOG(FATAL) << "Memory allocation failed!";
             return false;
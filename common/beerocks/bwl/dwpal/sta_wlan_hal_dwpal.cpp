@@ -23,13 +23,6 @@ namespace dwpal {
 ////////////////////////// Local Module Definitions //////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-//Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 // Client connection status
 struct ConnectionStatus {
     std::string bssid;
@@ -52,18 +45,15 @@ struct ConnectionStatus {
 /*
     static sta_wlan_hal::Event fapi_to_bwl_event(const std::string& opcode)
     {
-        if (opcode == "CTRL-EVENT-CONNECTED") {
-            return sta_wlan_hal::Event::Connected;
-        } else if (opcode == "CTRL-EVENT-DISCONNECTED") {
-            return sta_wlan_hal::Event::Disconnected;
-        } else if (opcode == "CTRL-EVENT-TERMINATING") {
-            return sta_wlan_hal::Event::Terminating;
-        } else if (opcode == "CTRL-EVENT-SCAN-RESULTS") {
-            return sta_wlan_hal::Event::ScanResults;
-        } else if (opcode == "CTRL-EVENT-CHANNEL-SWITCH") {
-            return sta_wlan_hal::Event::ChannelSwitch;
-        } else if (opcode == "UNCONNECTED-STA-RSSI") {
-            return sta_wlan_hal::Event::STA_Unassoc_RSSI;
+        switch (event_opcode_hash(opcode)) {
+            EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-CONNECTED", sta_wlan_hal::Event::Connected);
+            EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-DISCONNECTED", sta_wlan_hal::Event::Disconnected);
+            EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-TERMINATING", sta_wlan_hal::Event::Terminating);
+            EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-SCAN-RESULTS", sta_wlan_hal::Event::ScanResults);
+            EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-CHANNEL-SWITCH",
+                              sta_wlan_hal::Event::ChannelSwitch);
+            EVENT_OPCODE_CASE(opcode, "UNCONNECTED-STA-RSSI",
+                              sta_wlan_hal::Event::STA_Unassoc_RSSI);
         }
 
         return sta_wlan_hal::Event::Invalid;
@@ -664,7 +654,7 @@ bool sta_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
             case Event::Disconnected: {
 
                 // TODO: Change to HAL objects
-                auto msg_buff = ALLOC_SMART_BUFFER(sizeof(beerocks::message::sACTION_BACKHAUL_DISCONNECT_REASON_NOTIFICATION));
+                auto msg_buff = alloc_event_buffer(sizeof(beerocks::message::sACTION_BACKHAUL_DISCONNECT_REASON_NOTIFICATION));
                 auto msg = reinterpret_cast<beerocks::message::sACTION_BACKHAUL_DISCONNECT_REASON_NOTIFICATION*>(msg_buff.get());
                 LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
@@ -703,7 +693,7 @@ bool sta_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
             case Event::STA_Unassoc_RSSI: {
 
                 // TODO: Change to HAL objects
-                auto msg_buff = ALLOC_SMART_BUFFER(sizeof(beerocks::message::sACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
+                auto msg_buff = alloc_event_buffer(sizeof(beerocks::message::sACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
                 auto msg = reinterpret_cast<beerocks::message::sACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE*>(msg_buff.get());
                 LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
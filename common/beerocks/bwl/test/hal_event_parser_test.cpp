@@ -0,0 +1,142 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "../common/hal_event_parser.h"
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace bwl;
+
+struct sParsedEvent {
+    std::vector<std::string> params;
+    std::map<std::string, std::string> pairs;
+};
+
+static sParsedEvent parse(const std::string &event)
+{
+    sParsedEvent parsed;
+    event_tokenizer tokenizer(event.c_str(), event.length());
+    event_tokenizer::sToken key, value;
+
+    while (tokenizer.next_param(value)) {
+        parsed.params.push_back(value.to_string());
+    }
+    while (tokenizer.next_pair(key, value)) {
+        parsed.pairs[key.to_string()] = value.to_string();
+    }
+    return parsed;
+}
+
+static bool check(const std::string &event, const std::vector<std::string> &params,
+                  const std::map<std::string, std::string> &pairs)
+{
+    auto parsed = parse(event);
+    if (parsed.params != params || parsed.pairs != pairs) {
+        std::cout << "unexpected tokens of: " << event << std::endl;
+        for (const auto &param : parsed.params) {
+            std::cout << "    param: |" << param << "|" << std::endl;
+        }
+        for (const auto &pair : parsed.pairs) {
+            std::cout << "    pair: |" << pair.first << "|=|" << pair.second << "|" << std::endl;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool test_event_tokenizer()
+{
+    std::cout << "START test_event_tokenizer" << std::endl;
+    bool ok = true;
+
+    // keyless params only
+    ok &= check("<3>AP-ENABLED wlan2", {"AP-ENABLED", "wlan2"}, {});
+
+    ok &= check("<3>AP-STA-DISCONNECTED wlan0.1 11:22:33:44:55:66",
+                {"AP-STA-DISCONNECTED", "wlan0.1", "11:22:33:44:55:66"}, {});
+
+    // values containing spaces end at the last space before the next key
+    ok &= check("<3>AP-STA-CONNECTED wlan0 11:22:33:44:55:66 SupportedRates=2 4 11 22 "
+                "HT_CAP=a HT_MCS=ff ff",
+                {"AP-STA-CONNECTED", "wlan0", "11:22:33:44:55:66"},
+                {{"SupportedRates", "2 4 11 22"}, {"HT_CAP", "a"}, {"HT_MCS", "ff ff"}});
+
+    ok &= check("<3>UNCONNECTED-STA-RSSI wlan0 11:22:33:44:55:66 rx_bytes=0 rx_packets=0 "
+                "rssi=-40 -50 -128 -128 SNR=30 20 0 0 rate=1",
+                {"UNCONNECTED-STA-RSSI", "wlan0", "11:22:33:44:55:66"},
+                {{"rx_bytes", "0"},
+                 {"rx_packets", "0"},
+                 {"rssi", "-40 -50 -128 -128"},
+                 {"SNR", "30 20 0 0"},
+                 {"rate", "1"}});
+
+    ok &= check("<3>AP-CSA-FINISHED wlan0 Channel=36 OperatingChannelBandwidt=80 "
+                "ExtensionChannel=1 cf1=5210 cf2=0 reason=RADAR dfs_chan=1",
+                {"AP-CSA-FINISHED", "wlan0"},
+                {{"Channel", "36"},
+                 {"OperatingChannelBandwidt", "80"},
+                 {"ExtensionChannel", "1"},
+                 {"cf1", "5210"},
+                 {"cf2", "0"},
+                 {"reason", "RADAR"},
+                 {"dfs_chan", "1"}});
+
+    // no log level prefix
+    ok &= check("ACS-STARTED wlan0", {"ACS-STARTED", "wlan0"}, {});
+
+    // a key without a value
+    ok &= check("<3>EVENT wlan0 key= other=1", {"EVENT", "wlan0"}, {{"key", ""}, {"other", "1"}});
+
+    // the remains of a malformed pair are skipped, the parser of the wav backend used to turn
+    // them into a "b c" key
+    ok &= check("<3>EVENT k=a=b c=d", {"EVENT"}, {{"k", "a"}, {"c", "d"}});
+
+    std::cout << "END test_event_tokenizer " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+enum class eTestEvent { Invalid, Enabled, Disabled };
+
+static eTestEvent to_test_event(const std::string &opcode)
+{
+    switch (event_opcode_hash(opcode)) {
+        EVENT_OPCODE_CASE(opcode, "AP-ENABLED", eTestEvent::Enabled);
+        EVENT_OPCODE_CASE(opcode, "AP-DISABLED", eTestEvent::Disabled);
+    }
+
+    return eTestEvent::Invalid;
+}
+
+bool test_event_opcode_dispatch()
+{
+    std::cout << "START test_event_opcode_dispatch" << std::endl;
+    bool ok = true;
+
+    static_assert(event_opcode_hash("AP-ENABLED") != event_opcode_hash("AP-DISABLED"),
+                  "opcode hash collision");
+    ok &= event_opcode_hash(std::string("AP-ENABLED")) == event_opcode_hash("AP-ENABLED");
+
+    ok &= to_test_event("AP-ENABLED") == eTestEvent::Enabled;
+    ok &= to_test_event("AP-DISABLED") == eTestEvent::Disabled;
+    ok &= to_test_event("AP-ENABLE") == eTestEvent::Invalid;
+    ok &= to_test_event("") == eTestEvent::Invalid;
+
+    std::cout << "END test_event_opcode_dispatch " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok &= test_event_tokenizer();
+    ok &= test_event_opcode_dispatch();
+    return ok ? 0 : 1;
+}
@@ -7,6 +7,7 @@
  */
 
 #include "base_wlan_hal_wav.h"
+#include "../common/hal_event_parser.h"
 
 #include <beerocks/bcl/beerocks_string_utils.h>
 #include <beerocks/bcl/beerocks_utils.h>
@@ -110,72 +111,35 @@ static void listed_map_obj_parser(std::stringstream &ss_in, std::list<char> deli
     }
 }
 
-static std::string::size_type find_first_of_delimiter_pair(std::string &str,
-                                                           std::string::size_type pos,
-                                                           char delim_near, char delim_far)
+// The handlers look the fields up by key, so each event still allocates map_obj and copies of
+// its tokens
+static void map_event_obj_parser(const char *event_str, size_t event_len,
+                                 parsed_obj_map_t &map_obj)
 {
-    // finds first occurrence on string 'str' of <'delim_near'><any_characters except delimiters><'delim_far'>
-    auto idx = str.find_first_of(delim_far, pos);
-    if (idx == std::string::npos) {
-        return idx;
-    }
-    idx = str.rfind(delim_near, idx);
-    return idx;
-}
+    event_tokenizer tokenizer(event_str, event_len);
+    event_tokenizer::sToken key, value;
 
-static void map_event_obj_parser(std::string event_str, parsed_obj_map_t &map_obj)
-{
-    // eliminate event log level from the begining of the event string : "<3>"
-    auto idx_start = event_str.find_first_of(">");
-    if (idx_start != std::string::npos) {
-        idx_start++;
-    } else {
+    // insert to map known prams without key, assume that the first param is event name
+    if (!tokenizer.next_param(value)) {
         LOG(WARNING) << "empty event! event_string: " << event_str;
+        return;
     }
+    map_obj[WAV_EVENT_KEYLESS_PARAM_OPCODE].assign(value.str, value.len);
 
-    // find params without key end index
-    auto idx = find_first_of_delimiter_pair(event_str, idx_start, ' ', '=');
-
-    // put null terminator at the end of our key=val, for ss construction
-    if (idx != std::string::npos) {
-        event_str[idx] = '\0';
-    }
-
-    // insert to map known prams without key
-    std::stringstream ss(event_str.c_str() + idx_start);
-    std::string str_storage;
-    bool opcode = true;
-    while (std::getline(ss, str_storage, ' ')) {
-        if (opcode) {
-            // assume that the first param is event name
-            map_obj[WAV_EVENT_KEYLESS_PARAM_OPCODE] = str_storage;
-            opcode                                  = false;
-        } else if (beerocks::net::network_utils::is_valid_mac(str_storage)) {
-            map_obj[WAV_EVENT_KEYLESS_PARAM_MAC] = str_storage;
-        } else if (!strncmp(str_storage.c_str(), "wlan", 4)) {
-            map_obj[WAV_EVENT_KEYLESS_PARAM_IFACE] = str_storage;
+    while (tokenizer.next_param(value)) {
+        if (value.len == beerocks::net::MAC_ADDR_LEN * 3 - 1 &&
+            beerocks::net::network_utils::is_valid_mac(value.to_string())) {
+            map_obj[WAV_EVENT_KEYLESS_PARAM_MAC].assign(value.str, value.len);
+        } else if (value.len >= 4 && !strncmp(value.str, "wlan", 4)) {
+            map_obj[WAV_EVENT_KEYLESS_PARAM_IFACE].assign(value.str, value.len);
         }
     }
 
     // fill the map with the rest of event data
-    while (idx != std::string::npos) {
-
-        idx_start = ++idx;
-
-        // find first '=' to skip on it
-        idx = event_str.find_first_of('=', idx_start);
-
-        // find the next pair of delimiters index
-        idx = find_first_of_delimiter_pair(event_str, ++idx, ' ', '=');
-
-        if (idx != std::string::npos) {
-            // put null terminator at the end of our key=val, for ss_in construction
-            event_str[idx] = '\0';
+    while (tokenizer.next_pair(key, value)) {
+        if (value.len) {
+            map_obj[key.to_string()].assign(value.str, value.len);
         }
-
-        // parse key=val
-        std::stringstream ss_in(event_str.c_str() + idx_start);
-        map_obj_parser(ss_in, {'='}, map_obj);
     }
 }
 
@@ -832,7 +796,7 @@ bool base_wlan_hal_wav::process_ext_events()
     LOG(DEBUG) << "event received:" << std::endl << buffer;
 
     parsed_obj_map_t event_obj;
-    map_event_obj_parser(buffer, event_obj);
+    map_event_obj_parser(buffer, buff_size_copy, event_obj);
 
     base_wlan_hal_wav::parsed_obj_debug(event_obj);
 
@@ -7,6 +7,7 @@
  */
 
 #include "mon_wlan_hal_wav.h"
+#include "../common/hal_event_parser.h"
 
 #include <beerocks/bcl/beerocks_utils.h>
 #include <beerocks/bcl/network/network_utils.h>
@@ -33,27 +34,21 @@ namespace wav {
 #define GET_OP_CLASS(channel) ((channel < 14) ? 4 : 5)
 #define BUFFER_SIZE 4096
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////////// Local Module Functions ///////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
 static mon_wlan_hal::Event wav_to_bwl_event(const std::string &opcode)
 {
-    if (opcode == "RRM-CHANNEL-LOAD-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Channel_Load_Response;
-    } else if (opcode == "RRM-BEACON-REP-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Beacon_Response;
-    } else if (opcode == "RRM-STA-STATISTICS-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_STA_Statistics_Response;
-    } else if (opcode == "RRM-LINK-MEASUREMENT-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Link_Measurement_Response;
+    switch (event_opcode_hash(opcode)) {
+        EVENT_OPCODE_CASE(opcode, "RRM-CHANNEL-LOAD-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Channel_Load_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-BEACON-REP-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Beacon_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-STA-STATISTICS-RECEIVED",
+                          mon_wlan_hal::Event::RRM_STA_Statistics_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-LINK-MEASUREMENT-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Link_Measurement_Response);
     }
 
     return mon_wlan_hal::Event::Invalid;
@@ -474,7 +469,7 @@ bool mon_wlan_hal_wav::process_wav_event(parsed_obj_map_t &parsed_obj)
     case Event::RRM_Beacon_Response: {
 
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SBeaconResponse11k));
+        auto resp_buff = alloc_event_buffer(sizeof(SBeaconResponse11k));
         auto resp      = reinterpret_cast<SBeaconResponse11k *>(resp_buff.get());
         LOG_IF(!resp, FATAL) << "Memory allocation failed!";
 
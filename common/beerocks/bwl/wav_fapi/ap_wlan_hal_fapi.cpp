@@ -7,6 +7,7 @@
  */
 
 #include "ap_wlan_hal_fapi.h"
+#include "../common/hal_event_parser.h"
 
 #include <beerocks/bcl/beerocks_os_utils.h>
 #include <beerocks/bcl/beerocks_utils.h>
@@ -61,13 +62,6 @@ namespace wav_fapi {
 
 #define CSA_EVENT_FILTERING_TIMEOUT_MS 1000
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 // Temporary storage for station capabilities
 struct SRadioCapabilitiesStrings {
     std::string supported_rates;
@@ -87,36 +81,22 @@ struct SRadioCapabilitiesStrings {
 
 static ap_wlan_hal::Event fapi_to_bwl_event(const std::string &opcode)
 {
-    if (opcode == "AP-ENABLED") {
-        return ap_wlan_hal::Event::AP_Enabled;
-    } else if (opcode == "AP-DISABLED") {
-        return ap_wlan_hal::Event::AP_Disabled;
-    } else if (opcode == "AP-STA-CONNECTED") {
-        return ap_wlan_hal::Event::STA_Connected;
-    } else if (opcode == "AP-STA-DISCONNECTED") {
-        return ap_wlan_hal::Event::STA_Disconnected;
-    } else if (opcode == "UNCONNECTED_STA_RSSI") {
-        return ap_wlan_hal::Event::STA_Unassoc_RSSI;
-    } else if (opcode == "INTERFACE-ENABLED") {
-        return ap_wlan_hal::Event::Interface_Enabled;
-    } else if (opcode == "INTERFACE-DISABLED") {
-        return ap_wlan_hal::Event::Interface_Disabled;
-    } else if (opcode == "ACS-STARTED") {
-        return ap_wlan_hal::Event::ACS_Started;
-    } else if (opcode == "ACS-COMPLETED") {
-        return ap_wlan_hal::Event::ACS_Completed;
-    } else if (opcode == "ACS-FAILED") {
-        return ap_wlan_hal::Event::ACS_Failed;
-    } else if (opcode == "AP-CSA-FINISHED") {
-        return ap_wlan_hal::Event::CSA_Finished;
-    } else if (opcode == "BSS-TM-RESP") {
-        return ap_wlan_hal::Event::BSS_TM_Response;
-    } else if (opcode == "DFS-CAC-COMPLETED") {
-        return ap_wlan_hal::Event::DFS_CAC_Completed;
-    } else if (opcode == "DFS-NOP-FINISHED") {
-        return ap_wlan_hal::Event::DFS_NOP_Finished;
-    } else if (opcode == "DFS-RADAR-DETECTED") {
-        return ap_wlan_hal::Event::DFS_RADAR_Detected;
+    switch (event_opcode_hash(opcode)) {
+        EVENT_OPCODE_CASE(opcode, "AP-ENABLED", ap_wlan_hal::Event::AP_Enabled);
+        EVENT_OPCODE_CASE(opcode, "AP-DISABLED", ap_wlan_hal::Event::AP_Disabled);
+        EVENT_OPCODE_CASE(opcode, "AP-STA-CONNECTED", ap_wlan_hal::Event::STA_Connected);
+        EVENT_OPCODE_CASE(opcode, "AP-STA-DISCONNECTED", ap_wlan_hal::Event::STA_Disconnected);
+        EVENT_OPCODE_CASE(opcode, "UNCONNECTED_STA_RSSI", ap_wlan_hal::Event::STA_Unassoc_RSSI);
+        EVENT_OPCODE_CASE(opcode, "INTERFACE-ENABLED", ap_wlan_hal::Event::Interface_Enabled);
+        EVENT_OPCODE_CASE(opcode, "INTERFACE-DISABLED", ap_wlan_hal::Event::Interface_Disabled);
+        EVENT_OPCODE_CASE(opcode, "ACS-STARTED", ap_wlan_hal::Event::ACS_Started);
+        EVENT_OPCODE_CASE(opcode, "ACS-COMPLETED", ap_wlan_hal::Event::ACS_Completed);
+        EVENT_OPCODE_CASE(opcode, "ACS-FAILED", ap_wlan_hal::Event::ACS_Failed);
+        EVENT_OPCODE_CASE(opcode, "AP-CSA-FINISHED", ap_wlan_hal::Event::CSA_Finished);
+        EVENT_OPCODE_CASE(opcode, "BSS-TM-RESP", ap_wlan_hal::Event::BSS_TM_Response);
+        EVENT_OPCODE_CASE(opcode, "DFS-CAC-COMPLETED", ap_wlan_hal::Event::DFS_CAC_Completed);
+        EVENT_OPCODE_CASE(opcode, "DFS-NOP-FINISHED", ap_wlan_hal::Event::DFS_NOP_Finished);
+        EVENT_OPCODE_CASE(opcode, "DFS-RADAR-DETECTED", ap_wlan_hal::Event::DFS_RADAR_Detected);
     }
 
     return ap_wlan_hal::Event::Invalid;
@@ -1165,7 +1145,7 @@ bool ap_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_p
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1274,7 +1254,7 @@ bool ap_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_p
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1309,7 +1289,7 @@ bool ap_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_p
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
         auto msg = reinterpret_cast<sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1388,7 +1368,7 @@ bool ap_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_p
     case Event::BSS_TM_Response: {
 
         // TODO: Change to HAL objects
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
+        auto msg_buff = alloc_event_buffer(sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
         auto msg = reinterpret_cast<sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
@@ -1426,7 +1406,7 @@ bool ap_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_p
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION));
         auto msg = reinterpret_cast<sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1478,7 +1458,7 @@ bool ap_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_p
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION));
+            alloc_event_buffer(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION));
         auto msg = reinterpret_cast<sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
@@ -1519,7 +1499,7 @@ bool ap_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_p
     } break;
 
     case Event::AP_Disabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
+        auto msg_buff = alloc_event_buffer(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
         auto msg      = reinterpret_cast<sHOSTAP_DISABLED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
@@ -7,6 +7,7 @@
  */
 
 #include "mon_wlan_hal_fapi.h"
+#include "../common/hal_event_parser.h"
 
 #include <beerocks/bcl/beerocks_utils.h>
 #include <beerocks/bcl/network/network_utils.h>
@@ -57,13 +58,6 @@ namespace wav_fapi {
 ////////////////////////// Local Module Definitions //////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 #define GET_OP_CLASS(channel) ((channel < 14) ? 4 : 5)
 
 //////////////////////////////////////////////////////////////////////////////
@@ -91,14 +85,15 @@ static void wav_fapi_debug_obj(const std::shared_ptr<ObjList> &debug_obj, const
 
 static mon_wlan_hal::Event fapi_to_bwl_event(const std::string &opcode)
 {
-    if (opcode == "RRM-CHANNEL-LOAD-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Channel_Load_Response;
-    } else if (opcode == "RRM-BEACON-REP-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Beacon_Response;
-    } else if (opcode == "RRM-STA-STATISTICS-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_STA_Statistics_Response;
-    } else if (opcode == "RRM-LINK-MEASUREMENT-RECEIVED") {
-        return mon_wlan_hal::Event::RRM_Link_Measurement_Response;
+    switch (event_opcode_hash(opcode)) {
+        EVENT_OPCODE_CASE(opcode, "RRM-CHANNEL-LOAD-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Channel_Load_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-BEACON-REP-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Beacon_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-STA-STATISTICS-RECEIVED",
+                          mon_wlan_hal::Event::RRM_STA_Statistics_Response);
+        EVENT_OPCODE_CASE(opcode, "RRM-LINK-MEASUREMENT-RECEIVED",
+                          mon_wlan_hal::Event::RRM_Link_Measurement_Response);
     }
 
     return mon_wlan_hal::Event::Invalid;
@@ -841,7 +836,7 @@ bool mon_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_
     case Event::RRM_Channel_Load_Response: {
 
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SStaChannelLoadResponse11k));
+        auto resp_buff = alloc_event_buffer(sizeof(SStaChannelLoadResponse11k));
         auto resp      = reinterpret_cast<SStaChannelLoadResponse11k *>(resp_buff.get());
         LOG_IF(!resp, FATAL) << "Memory allocation failed!";
 
@@ -942,7 +937,7 @@ bool mon_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_
     case Event::RRM_Beacon_Response: {
 
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SBeaconResponse11k));
+        auto resp_buff = alloc_event_buffer(sizeof(SBeaconResponse11k));
         auto resp      = reinterpret_cast<SBeaconResponse11k *>(resp_buff.get());
         LOG_IF(!resp, FATAL) << "Memory allocation failed!";
 
@@ -1081,7 +1076,7 @@ bool mon_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_
     case Event::RRM_STA_Statistics_Response: {
 
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SStatisticsResponse11k));
+        auto resp_buff = alloc_event_buffer(sizeof(SStatisticsResponse11k));
         auto resp      = reinterpret_cast<SStatisticsResponse11k *>(resp_buff.get());
         LOG_IF(!resp, FATAL) << "Memory allocation failed!";
 
@@ -1167,7 +1162,7 @@ bool mon_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_
     case Event::RRM_Link_Measurement_Response: {
 
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SLinkMeasurementsResponse11k));
+        auto resp_buff = alloc_event_buffer(sizeof(SLinkMeasurementsResponse11k));
         auto resp      = reinterpret_cast<SLinkMeasurementsResponse11k *>(resp_buff.get());
         LOG_IF(!resp, FATAL) << "Memory allocation failed!";
 
@@ -7,6 +7,7 @@
  */
 
 #include "sta_wlan_hal_fapi.h"
+#include "../common/hal_event_parser.h"
 
 #include <beerocks/bcl/beerocks_utils.h>
 #include <beerocks/bcl/network/network_utils.h>
@@ -55,13 +56,6 @@ namespace wav_fapi {
 ////////////////////////// Local Module Definitions //////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 // Client connection status
 struct ConnectionStatus {
     std::string bssid;
@@ -83,18 +77,13 @@ struct ConnectionStatus {
 
 static sta_wlan_hal::Event fapi_to_bwl_event(const std::string &opcode)
 {
-    if (opcode == "CTRL-EVENT-CONNECTED") {
-        return sta_wlan_hal::Event::Connected;
-    } else if (opcode == "CTRL-EVENT-DISCONNECTED") {
-        return sta_wlan_hal::Event::Disconnected;
-    } else if (opcode == "CTRL-EVENT-TERMINATING") {
-        return sta_wlan_hal::Event::Terminating;
-    } else if (opcode == "CTRL-EVENT-SCAN-RESULTS") {
-        return sta_wlan_hal::Event::ScanResults;
-    } else if (opcode == "CTRL-EVENT-CHANNEL-SWITCH") {
-        return sta_wlan_hal::Event::ChannelSwitch;
-    } else if (opcode == "UNCONNECTED-STA-RSSI") {
-        return sta_wlan_hal::Event::STA_Unassoc_RSSI;
+    switch (event_opcode_hash(opcode)) {
+        EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-CONNECTED", sta_wlan_hal::Event::Connected);
+        EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-DISCONNECTED", sta_wlan_hal::Event::Disconnected);
+        EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-TERMINATING", sta_wlan_hal::Event::Terminating);
+        EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-SCAN-RESULTS", sta_wlan_hal::Event::ScanResults);
+        EVENT_OPCODE_CASE(opcode, "CTRL-EVENT-CHANNEL-SWITCH", sta_wlan_hal::Event::ChannelSwitch);
+        EVENT_OPCODE_CASE(opcode, "UNCONNECTED-STA-RSSI", sta_wlan_hal::Event::STA_Unassoc_RSSI);
     }
 
     return sta_wlan_hal::Event::Invalid;
@@ -356,7 +345,10 @@ sta_wlan_hal_fapi::sta_wlan_hal_fapi(std::string iface_name, hal_event_cb_t call
       base_wlan_hal_fapi(bwl::HALType::Station, iface_name, IfaceType::Intel, false, callback)
 {
     // Pointer for parsing FAPI object values
-    m_temp_fapi_value = ALLOC_SMART_BUFFER(MAX_LEN_PARAM_VALUE);
+    m_temp_fapi_value = std::shared_ptr<char>(new char[MAX_LEN_PARAM_VALUE], [](char *obj) {
+        if (obj)
+            delete[] obj;
+    });
 }
 
 sta_wlan_hal_fapi::~sta_wlan_hal_fapi() { detach(); }
@@ -796,7 +788,7 @@ bool sta_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_
     case Event::Disconnected: {
 
         // TODO: Change to HAL objects
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sACTION_BACKHAUL_DISCONNECT_REASON_NOTIFICATION));
+        auto msg_buff = alloc_event_buffer(sizeof(sACTION_BACKHAUL_DISCONNECT_REASON_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_BACKHAUL_DISCONNECT_REASON_NOTIFICATION *>(msg_buff.get());
         if (!msg) {
@@ -841,7 +833,7 @@ bool sta_wlan_hal_fapi::parse_fapi_event(const std::string &opcode, std::shared_
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
+            alloc_event_buffer(sizeof(sACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
         auto msg = reinterpret_cast<sACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE *>(
             msg_buff.get());
         if (!msg) {
@@ -108,6 +108,7 @@ enum eActionOp_CONTROL: uint8_t {
     ACTION_CONTROL_STEERING_EVENT_SNR_XING_NOTIFICATION = 0x84,
     ACTION_CONTROL_STEERING_EVENT_PROBE_REQ_NOTIFICATION = 0x85,
     ACTION_CONTROL_STEERING_EVENT_AUTH_FAIL_NOTIFICATION = 0x86,
+    ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION = 0x87,
     ACTION_CONTROL_WIFI_CREDENTIALS_UPDATE_PREPARE_REQUEST = 0xc8,
     ACTION_CONTROL_WIFI_CREDENTIALS_UPDATE_PREPARE_RESPONSE = 0xc9,
     ACTION_CONTROL_WIFI_CREDENTIALS_UPDATE_PRE_COMMIT_REQUEST = 0xca,
@@ -258,6 +259,7 @@ enum eActionOp_MONITOR: uint8_t {
     ACTION_MONITOR_STEERING_CLIENT_SET_RESPONSE = 0x28,
     ACTION_MONITOR_STEERING_EVENT_CLIENT_ACTIVITY_NOTIFICATION = 0x29,
     ACTION_MONITOR_STEERING_EVENT_SNR_XING_NOTIFICATION = 0x2a,
+    ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION = 0x2b,
     ACTION_MONITOR_HOSTAP_STATS_MEASUREMENT_REQUEST = 0x32,
     ACTION_MONITOR_HOSTAP_STATS_MEASUREMENT_RESPONSE = 0x33,
     ACTION_MONITOR_HOSTAP_LOAD_MEASUREMENT_NOTIFICATION = 0x34,
@@ -119,6 +119,8 @@ class cACTION_BML_NW_MAP_UPDATE : public BaseClass
         static eActionOp_BML get_action_op(){
             return (eActionOp_BML)(ACTION_BML_NW_MAP_UPDATE);
         }
+        uint32_t& sequence_num();
+        uint8_t& snapshot();
         uint32_t& node_num();
         uint32_t& buffer_size();
         char* buffer(size_t length = 0);
@@ -132,6 +134,8 @@ class cACTION_BML_NW_MAP_UPDATE : public BaseClass
     private:
         bool init();
         eActionOp_BML* m_action_op = nullptr;
+        uint32_t* m_sequence_num = nullptr;
+        uint8_t* m_snapshot = nullptr;
         uint32_t* m_node_num = nullptr;
         uint32_t* m_buffer_size = nullptr;
         char* m_buffer = nullptr;
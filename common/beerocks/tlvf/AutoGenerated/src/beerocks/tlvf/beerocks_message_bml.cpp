@@ -229,6 +229,14 @@ BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse, swap_needed)
 }
 cACTION_BML_NW_MAP_UPDATE::~cACTION_BML_NW_MAP_UPDATE() {
 }
+uint32_t& cACTION_BML_NW_MAP_UPDATE::sequence_num() {
+    return (uint32_t&)(*m_sequence_num);
+}
+
+uint8_t& cACTION_BML_NW_MAP_UPDATE::snapshot() {
+    return (uint8_t&)(*m_snapshot);
+}
+
 uint32_t& cACTION_BML_NW_MAP_UPDATE::node_num() {
     return (uint32_t&)(*m_node_num);
 }
@@ -287,6 +295,7 @@ bool cACTION_BML_NW_MAP_UPDATE::alloc_buffer(size_t count) {
 
 void cACTION_BML_NW_MAP_UPDATE::class_swap()
 {
+    tlvf_swap(32, reinterpret_cast<uint8_t*>(m_sequence_num));
     tlvf_swap(32, reinterpret_cast<uint8_t*>(m_node_num));
     tlvf_swap(32, reinterpret_cast<uint8_t*>(m_buffer_size));
 }
@@ -294,6 +303,8 @@ void cACTION_BML_NW_MAP_UPDATE::class_swap()
 size_t cACTION_BML_NW_MAP_UPDATE::get_initial_size()
 {
     size_t class_size = 0;
+    class_size += sizeof(uint32_t); // sequence_num
+    class_size += sizeof(uint8_t); // snapshot
     class_size += sizeof(uint32_t); // node_num
     class_size += sizeof(uint32_t); // buffer_size
     return class_size;
@@ -305,6 +316,10 @@ bool cACTION_BML_NW_MAP_UPDATE::init()
         TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
         return false;
     }
+    m_sequence_num = (uint32_t*)m_buff_ptr__;
+    m_buff_ptr__ += sizeof(uint32_t) * 1;
+    m_snapshot = (uint8_t*)m_buff_ptr__;
+    m_buff_ptr__ += sizeof(uint8_t) * 1;
     m_node_num = (uint32_t*)m_buff_ptr__;
     m_buff_ptr__ += sizeof(uint32_t) * 1;
     m_buffer_size = (uint32_t*)m_buff_ptr__;
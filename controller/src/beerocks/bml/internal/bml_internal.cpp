@@ -539,6 +539,25 @@ int bml_internal::process_cmdu_header(cmdu_vs_action_header_t beerocks_header,
         case beerocks_message::ACTION_BML_NW_MAP_UPDATE: {
             auto response         = cmdu_rx.addClass<beerocks_message::cACTION_BML_NW_MAP_UPDATE>();
             uint32_t num_of_nodes = response->node_num();
+            uint32_t sequence_num = response->sequence_num();
+
+            if (response->snapshot()) {
+                // Deltas continue from the sequence number of the snapshot
+                if (beerocks_header->last()) {
+                    m_fNetMapUpdateSynced = true;
+                    m_uiNetMapUpdateSeq   = sequence_num;
+                }
+            } else if (m_fNetMapUpdateSynced) {
+                if (sequence_num != m_uiNetMapUpdateSeq + 1) {
+                    LOG(WARNING) << "Network map update gap, expected sequence_num="
+                                 << m_uiNetMapUpdateSeq + 1 << " received=" << sequence_num
+                                 << ", requesting a new snapshot";
+                    m_fNetMapUpdateSynced = false;
+                    request_nw_map_snapshot();
+                } else {
+                    m_uiNetMapUpdateSeq = sequence_num;
+                }
+            }
 
             auto firstNode = response->buffer(0);
             // Process the message
@@ -1251,7 +1270,8 @@ int bml_internal::register_nw_map_update_cb(BML_NW_MAP_QUERY_CB pCB)
         return (-BML_RET_OP_NOT_SUPPORTED);
     }
 
-    m_cbNetMapUpdate = pCB;
+    m_cbNetMapUpdate      = pCB;
+    m_fNetMapUpdateSynced = false;
 
     // Build and send the message
     if (m_cbNetMapUpdate) {
@@ -1287,6 +1307,29 @@ int bml_internal::register_nw_map_update_cb(BML_NW_MAP_QUERY_CB pCB)
     return (BML_RET_OK);
 }
 
+bool bml_internal::request_nw_map_snapshot()
+{
+    // Called from the socket thread, use a private buffer instead of the shared cmdu_tx
+    uint8_t tx_buffer[message::MESSAGE_BUFFER_LENGTH];
+    ieee1905_1::CmduMessageTx snapshot_cmdu_tx(tx_buffer, sizeof(tx_buffer));
+
+    // Registering again makes the master send a full snapshot
+    auto request = message_com::create_vs_message<
+        beerocks_message::cACTION_BML_REGISTER_TO_NW_MAP_UPDATES_REQUEST>(snapshot_cmdu_tx);
+
+    if (request == nullptr) {
+        LOG(ERROR) << "Failed building ACTION_BML_REGISTER_TO_NW_MAP_UPDATES_REQUEST message!";
+        return false;
+    }
+
+    if (!message_com::send_cmdu(m_sockMaster, snapshot_cmdu_tx)) {
+        LOG(ERROR) << "Failed sending ACTION_BML_REGISTER_TO_NW_MAP_UPDATES_REQUEST message!";
+        return false;
+    }
+
+    return true;
+}
+
 int bml_internal::nw_map_query()
 {
     // Command supported only on local master
@@ -196,6 +196,7 @@ private:
     bool handle_nw_map_query_update(int elements_num, int last_node, void *data_buffer,
                                     bool is_query);
     bool handle_stats_update(int elements_num, void *data_buffer);
+    bool request_nw_map_snapshot();
     bool handle_event_update(uint8_t *data_buffer);
     virtual bool handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx) override;
     // Send message contained in cmdu to m_sockMaster,
@@ -233,6 +234,10 @@ private:
     BML_STATS_UPDATE_CB m_cbStatsUpdate  = nullptr;
     BML_EVENT_CB m_cbEvent               = nullptr;
 
+    // Network map updates stream state
+    bool m_fNetMapUpdateSynced   = false;
+    uint32_t m_uiNetMapUpdateSeq = 0;
+
     beerocks_message::sDeviceInfo *m_device_info                 = nullptr;
     beerocks_message::sWifiCredentials *m_wifi_credentials       = nullptr;
     beerocks_message::sAdminCredentials *m_admin_credentials     = nullptr;
@@ -18,6 +18,38 @@
 using namespace beerocks;
 using namespace son;
 
+#define MAC_ADDR_CHAR_SIZE 17
+
+// parses a lower case "xx:xx:xx:xx:xx:xx" key into the node_index key,
+// anything else (e.g. <al_mac>_<ruid> keys) is rejected
+static bool mac_key_from_string(const std::string &mac, uint64_t &key)
+{
+    if (mac.length() != MAC_ADDR_CHAR_SIZE) {
+        return false;
+    }
+
+    auto hex_value = [](char c) -> int {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        return -1;
+    };
+
+    sMacAddr addr;
+    for (int i = 0; i < net::MAC_ADDR_LEN; i++) {
+        int hi = hex_value(mac[3 * i]);
+        int lo = hex_value(mac[3 * i + 1]);
+        if (hi < 0 || lo < 0 || (i < net::MAC_ADDR_LEN - 1 && mac[3 * i + 2] != ':')) {
+            return false;
+        }
+        addr.oct[i] = uint8_t((hi << 4) | lo);
+    }
+    key = net::network_utils::mac_to_uint64(addr.oct);
+    return true;
+}
+
 void db::set_log_level_state(const beerocks::eLogLevel &log_level, const bool &new_state)
 {
     logger.set_log_level_state(log_level, new_state);
@@ -31,6 +63,12 @@ bool db::has_node(std::string mac)
     return (n != nullptr);
 }
 
+bool db::has_node(const sMacAddr &mac)
+{
+    auto n = get_node(mac);
+    return (n != nullptr);
+}
+
 bool db::add_virtual_node(std::string mac, std::string real_node_mac)
 {
     //TODO prototype code, untested
@@ -54,6 +92,7 @@ bool db::add_virtual_node(std::string mac, std::string real_node_mac)
      */
 
     nodes[real_node->hierarchy].insert(std::make_pair(mac, real_node));
+    index_node(mac, real_node);
     return true;
 }
 
@@ -76,11 +115,13 @@ bool db::add_node(std::string mac, std::string parent_mac, beerocks::eType type,
     auto n = get_node(mac);
     if (n) { // n is not nullptr
         LOG(DEBUG) << "node with mac " << mac << " already exists, updating";
+        unindex_node_attributes(n);
         n->set_type(type);
         if (n->parent_mac != parent_mac) {
             n->previous_parent_mac = n->parent_mac;
             n->parent_mac          = parent_mac;
         }
+        index_node_attributes(n);
         int old_hierarchy = get_node_hierarchy(n);
         if (old_hierarchy >= 0 && old_hierarchy < HIERARCHY_MAX) {
             nodes[old_hierarchy].erase(mac);
@@ -95,10 +136,13 @@ bool db::add_node(std::string mac, std::string parent_mac, beerocks::eType type,
         LOG(DEBUG) << "node with mac " << mac << " being created, the type is " << type;
         n             = std::make_shared<node>(type, mac);
         n->parent_mac = parent_mac;
+        index_node(mac, n);
+        index_node_attributes(n);
     }
     n->radio_identifier = radio_identifier;
     n->hierarchy        = new_hierarchy;
     nodes[new_hierarchy].insert(std::make_pair(mac, n));
+    bml_nw_map_node_changed(n);
 
     if (!radio_identifier.empty()) {
         std::string ruid_key = get_node_key(parent_mac, radio_identifier);
@@ -125,8 +169,9 @@ bool db::remove_node(std::string mac)
             std::string ruid_key =
                 get_node_key(it->second->parent_mac, it->second->radio_identifier);
             std::string node_mac = it->second->mac;
+            bml_nw_map_node_changed(it->second);
 
-            if (last_accessed_node_mac == mac) {
+            if (last_accessed_node_mac == mac || last_accessed_node == it->second) {
                 last_accessed_node_mac = std::string();
                 last_accessed_node     = nullptr;
             }
@@ -134,14 +179,18 @@ bool db::remove_node(std::string mac)
             // map may include 2 keys to same node - if so remove other key-node pair from map
             // if removed by mac
             if (mac == node_mac) {
+                unindex_node_attributes(it->second);
                 nodes[i].erase(it);
+                unindex_node(node_mac);
                 // if ruid_key exists for this node
                 if (!ruid_key.empty()) {
                     nodes[i].erase(ruid_key);
                 }
                 // if removed by ruid_key
             } else if (mac == ruid_key) {
+                unindex_node_attributes(it->second);
                 nodes[i].erase(node_mac);
+                unindex_node(node_mac);
             }
 
             return true;
@@ -157,7 +206,10 @@ bool db::set_node_type(std::string mac, beerocks::eType type)
     if (!n) {
         return false;
     }
+    unindex_node_attributes(n);
     n->set_type(type);
+    index_node_attributes(n);
+    bml_nw_map_node_changed(n);
     return true;
 }
 
@@ -170,6 +222,15 @@ beerocks::eType db::get_node_type(std::string mac)
     return n->get_type();
 }
 
+beerocks::eType db::get_node_type(const sMacAddr &mac)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        return beerocks::TYPE_UNDEFINED;
+    }
+    return n->get_type();
+}
+
 bool db::set_local_slave_mac(std::string mac)
 {
     if (!local_slave_mac.empty()) {
@@ -188,6 +249,7 @@ bool db::set_node_ipv4(std::string mac, std::string ipv4)
         return false;
     }
     n->ipv4 = ipv4;
+    bml_nw_map_node_changed(n);
     return true;
 }
 
@@ -344,6 +406,7 @@ bool db::set_node_name(std::string mac, std::string name)
         return false;
     }
     n->name = name;
+    bml_nw_map_node_changed(n);
     return true;
 }
 
@@ -364,6 +427,7 @@ bool db::set_node_state(std::string mac, beerocks::eNodeState state)
     }
     n->state             = state;
     n->last_state_change = std::chrono::steady_clock::now();
+    bml_nw_map_node_changed(n);
     return true;
 }
 
@@ -377,6 +441,17 @@ beerocks::eNodeState db::get_node_state(std::string mac)
     return n->state;
 }
 
+beerocks::eNodeState db::get_node_state(const sMacAddr &mac)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << net::network_utils::mac_to_string(mac)
+                     << " does not exist!";
+        return beerocks::STATE_MAX;
+    }
+    return n->state;
+}
+
 bool db::set_node_operational_state(std::string bridge_mac, bool operational)
 {
     auto n = get_node(bridge_mac);
@@ -613,6 +688,7 @@ bool db::set_hostap_active(std::string mac, bool active)
         return false;
     }
     n->hostap->active = active;
+    bml_nw_map_node_changed(n);
     return true;
 }
 
@@ -700,6 +776,17 @@ bool db::is_node_wireless(std::string mac)
     return utils::is_node_wireless(n->iface_type);
 }
 
+bool db::is_node_wireless(const sMacAddr &mac)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << net::network_utils::mac_to_string(mac)
+                     << " does not exist!";
+        return false;
+    }
+    return utils::is_node_wireless(n->iface_type);
+}
+
 Socket *db::get_node_socket(std::string mac)
 {
     auto n = get_node(mac);
@@ -718,6 +805,25 @@ Socket *db::get_node_socket(std::string mac)
     return n->socket;
 }
 
+Socket *db::get_node_socket(const sMacAddr &mac)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << net::network_utils::mac_to_string(mac)
+                     << " does not exist!";
+        return nullptr;
+    }
+    if (n->get_type() == beerocks::TYPE_SLAVE || n->get_type() == TYPE_ETH_SWITCH) {
+        const auto parent_mac = n->parent_mac;
+        n                     = get_node(parent_mac);
+        if (!n) {
+            LOG(WARNING) << __FUNCTION__ << " - node " << parent_mac << " does not exist!";
+            return nullptr;
+        }
+    }
+    return n->socket;
+}
+
 bool db::set_node_socket(std::string mac, Socket *socket)
 {
     auto n = get_node(mac);
@@ -773,24 +879,19 @@ int db::get_node_hierarchy(std::string mac)
 std::set<std::string> db::get_nodes(int type)
 {
     std::set<std::string> ret;
-    for (auto node_map : nodes) {
-        for (auto kv : node_map) {
-            if ((type < 0 || kv.second->get_type() == type) && (kv.second->mac == kv.first)) {
-                ret.insert(kv.first);
-            }
-        }
-    }
+    for_each_node(type, [&](const std::string &mac) { ret.insert(mac); });
     return ret;
 }
 
 std::set<std::string> db::get_device_nodes()
 {
     std::set<std::string> ret;
-    for (auto node_map : nodes) {
-        for (auto kv : node_map) {
-            if ((kv.second->get_type() != beerocks::TYPE_SLAVE) && (kv.second->mac == kv.first)) {
-                ret.insert(kv.first);
-            }
+    for (int t = 0; t < beerocks::TYPE_MAX; t++) {
+        if (t == beerocks::TYPE_SLAVE) {
+            continue;
+        }
+        for (const auto &n : nodes_by_type[t]) {
+            ret.insert(n->mac);
         }
     }
     return ret;
@@ -799,42 +900,30 @@ std::set<std::string> db::get_device_nodes()
 std::set<std::string> db::get_active_hostaps()
 {
     std::set<std::string> ret;
-    for (auto node_map : nodes) {
-        for (auto kv : node_map) {
-            if (kv.second->get_type() == beerocks::TYPE_SLAVE && kv.second->hostap != nullptr &&
-                kv.second->state == beerocks::STATE_CONNECTED && kv.first == kv.second->mac &&
-                kv.second->hostap->active) {
-                ret.insert(kv.first);
-            }
-        }
-    }
+    for_each_active_hostap([&](const std::string &mac) { ret.insert(mac); });
     return ret;
 }
 
 std::set<std::string> db::get_all_connected_ires()
 {
     std::set<std::string> ret;
-    for (auto node_map : nodes) {
-        for (auto kv : node_map) {
-            if (((kv.second->get_type() == beerocks::TYPE_IRE) &&
-                 (kv.second->state == beerocks::STATE_CONNECTED)) ||
-                (kv.second->get_type() == beerocks::TYPE_GW)) {
-                ret.insert(kv.first);
-            }
+    for (const auto &n : nodes_by_type[beerocks::TYPE_IRE]) {
+        if (n->state == beerocks::STATE_CONNECTED) {
+            ret.insert(n->mac);
         }
     }
+    for (const auto &n : nodes_by_type[beerocks::TYPE_GW]) {
+        ret.insert(n->mac);
+    }
     return ret;
 }
 
 std::set<std::string> db::get_all_backhaul_manager_slaves()
 {
     std::set<std::string> ret;
-    for (auto node_map : nodes) {
-        for (auto kv : node_map) {
-            if (kv.second->get_type() == beerocks::TYPE_SLAVE && kv.second->hostap != nullptr &&
-                kv.first == kv.second->mac && kv.second->hostap->is_backhaul_manager) {
-                ret.insert(kv.first);
-            }
+    for (const auto &n : nodes_by_type[beerocks::TYPE_SLAVE]) {
+        if (n->hostap != nullptr && n->hostap->is_backhaul_manager) {
+            ret.insert(n->mac);
         }
     }
     return ret;
@@ -843,18 +932,8 @@ std::set<std::string> db::get_all_backhaul_manager_slaves()
 std::set<std::string> db::get_nodes_from_hierarchy(int hierarchy, int type)
 {
     std::set<std::string> result;
-
-    if (hierarchy < 0 || hierarchy >= HIERARCHY_MAX) {
-        LOG(ERROR) << "invalid hierarchy";
-        return result;
-    }
-
-    for (auto kv : nodes[hierarchy]) {
-        if ((type < 0 || kv.second->get_type() == type) && (kv.second->mac == kv.first)) {
-            result.insert(kv.first);
-        }
-    }
-
+    for_each_node_in_hierarchy(hierarchy, type,
+                               [&](const std::string &mac) { result.insert(mac); });
     return result;
 }
 std::string db::get_gw_mac()
@@ -873,23 +952,25 @@ std::string db::get_gw_mac()
 std::set<std::string> db::get_node_subtree(std::string mac)
 {
     std::set<std::string> subtree;
+    for_each_node_in_subtree(mac, [&](const std::string &s) { subtree.insert(s); });
+    return subtree;
+}
 
+std::string db::get_node_parent(std::string mac)
+{
     auto n = get_node(mac);
     if (!n) {
         LOG(WARNING) << "node " << mac << " does not exist!";
+        return std::string();
     }
-    auto subtree_ = get_node_subtree(n);
-    for (auto s : subtree_) {
-        subtree.insert(s->mac);
-    }
-    return subtree;
+    return n->parent_mac;
 }
 
-std::string db::get_node_parent(std::string mac)
+std::string db::get_node_parent(const sMacAddr &mac)
 {
     auto n = get_node(mac);
     if (!n) {
-        LOG(WARNING) << "node " << mac << " does not exist!";
+        LOG(WARNING) << "node " << net::network_utils::mac_to_string(mac) << " does not exist!";
         return std::string();
     }
     return n->parent_mac;
@@ -957,56 +1038,24 @@ std::string db::get_node_previous_parent(std::string mac)
 std::set<std::string> db::get_node_siblings(std::string mac, int type)
 {
     std::set<std::string> siblings;
-    auto n = get_node(mac);
-
-    if (!n) {
-        LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist";
-        return siblings;
-    }
-
-    auto parent = get_node(n->parent_mac);
-    if (!parent) {
-        LOG(ERROR) << "parent for node " << mac << " does not exist";
-        return siblings;
-    }
-
-    int hierarchy = get_node_hierarchy(parent) + 1;
-    if (hierarchy >= 0 && hierarchy < HIERARCHY_MAX) {
-        for (auto &it : nodes[hierarchy]) {
-            if (it.first == it.second->mac) {
-                auto sib = it.second;
-                if ((sib->parent_mac == parent->mac) && (mac != sib->mac) &&
-                    (type == beerocks::TYPE_ANY || sib->get_type() == type)) {
-                    siblings.insert(sib->mac);
-                }
-            }
-        }
-    }
+    for_each_node_sibling(mac, type, [&](const std::string &sib) { siblings.insert(sib); });
     return siblings;
 }
 
 std::set<std::string> db::get_node_children(std::string mac, int type, int state)
 {
     std::set<std::string> children_macs;
-    auto n = get_node(mac);
-
-    if (!n) {
-        LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist";
-        return children_macs;
-    }
-
-    std::set<std::shared_ptr<node>> children_nodes;
-    if (n->mac == mac) {
-        children_nodes = get_node_children(n, type, state);
-    } else {
-        children_nodes = get_node_children(n, type, state, mac);
-    }
-    for (auto c : children_nodes) {
-        children_macs.insert(c->mac);
-    }
+    for_each_node_child(mac, type, state, [&](const std::string &c) { children_macs.insert(c); });
     return children_macs;
 }
 
+size_t db::count_node_children(const std::string &mac, int type, int state)
+{
+    size_t count = 0;
+    for_each_node_child(mac, type, state, [&](const std::string &) { count++; });
+    return count;
+}
+
 //
 // Capabilities
 //
@@ -1393,6 +1442,7 @@ bool db::set_hostap_vap_list(const std::string &mac,
         return false;
     }
     n->hostap->vaps_info = vap_list;
+    bml_nw_map_node_changed(n);
     return true;
 }
 
@@ -1412,6 +1462,7 @@ std::unordered_map<int8_t, sVapElement> &db::get_hostap_vap_list(const std::stri
 
 bool db::remove_vap(const std::string &radio_mac, int vap_id)
 {
+    bml_nw_map_node_changed(get_node(radio_mac));
     return (get_hostap_vap_list(radio_mac).erase(vap_id) == 1);
 }
 
@@ -1426,6 +1477,7 @@ bool db::add_vap(const std::string &radio_mac, int vap_id, std::string bssid, st
     vaps_info[vap_id].mac          = bssid;
     vaps_info[vap_id].ssid         = ssid;
     vaps_info[vap_id].backhaul_vap = backhual;
+    bml_nw_map_node_changed(get_node(radio_mac));
 
     return true;
 }
@@ -1433,20 +1485,7 @@ bool db::add_vap(const std::string &radio_mac, int vap_id, std::string bssid, st
 std::set<std::string> db::get_hostap_vaps_bssids(const std::string &mac)
 {
     std::set<std::string> bssid_set;
-    auto n = get_node(mac);
-    if (!n) {
-        LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist!";
-        return bssid_set;
-    }
-
-    if (n->get_type() != beerocks::TYPE_SLAVE) {
-        // Only slaves have vap's
-        return bssid_set;
-    }
-    auto vap_list = get_hostap_vap_list(mac);
-    for (auto &vap : vap_list) {
-        bssid_set.insert(vap.second.mac);
-    }
+    for_each_hostap_vap_bssid(mac, [&](const std::string &bssid) { bssid_set.insert(bssid); });
     return bssid_set;
 }
 
@@ -1521,6 +1560,25 @@ std::string db::get_node_parent_radio(const std::string &mac)
     return n->mac;
 }
 
+std::string db::get_node_parent_radio(const sMacAddr &mac)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << net::network_utils::mac_to_string(mac)
+                     << " does not exist!";
+        return std::string();
+    }
+    if (n->get_type() == beerocks::TYPE_CLIENT) {
+        const auto parent_bssid = n->parent_mac;
+        n                       = get_node(parent_bssid);
+        if (!n) {
+            LOG(WARNING) << __FUNCTION__ << " - node " << parent_bssid << " does not exist!";
+            return std::string();
+        }
+    }
+    return n->mac;
+}
+
 int8_t db::get_hostap_vap_id(const std::string &mac)
 {
     auto n = get_node(mac);
@@ -1713,6 +1771,7 @@ bool db::set_node_platform(std::string mac, beerocks::ePlatform platform)
         return false;
     }
     n->platform = platform;
+    bml_nw_map_node_changed(n);
     return true;
 }
 
@@ -1891,6 +1950,7 @@ bool db::set_hostap_cac_completed(std::string mac, bool enable)
         return false;
     }
     n->hostap->cac_completed = enable;
+    bml_nw_map_node_changed(n);
     return true;
 }
 
@@ -2156,9 +2216,17 @@ void db::add_bml_socket(Socket *sd)
 void db::remove_bml_socket(Socket *sd)
 {
     if (sd) {
+        bml_nw_map_requests.erase(
+            std::remove_if(bml_nw_map_requests.begin(), bml_nw_map_requests.end(),
+                           [&](const sBmlNwMapRequest &request) { return request.sd == sd; }),
+            bml_nw_map_requests.end());
+
         for (auto it = bml_listeners_sockets.begin(); it < bml_listeners_sockets.end(); it++) {
             if (sd == (*it).sd) {
                 bml_listeners_sockets.erase(it);
+                if (!is_bml_nw_map_listener_exist()) {
+                    bml_nw_map_changed_nodes.clear();
+                }
                 return;
             }
         }
@@ -2183,6 +2251,9 @@ bool db::set_bml_nw_map_update_enable(Socket *sd, bool update_enable)
         for (auto it = bml_listeners_sockets.begin(); it < bml_listeners_sockets.end(); it++) {
             if (sd == (*it).sd) {
                 (*it).map_updates = update_enable;
+                if (!is_bml_nw_map_listener_exist()) {
+                    bml_nw_map_changed_nodes.clear();
+                }
                 return true;
             }
         }
@@ -2248,6 +2319,49 @@ Socket *db::get_bml_socket_at(int idx)
     return nullptr;
 }
 
+bool db::is_bml_nw_map_listener_exist()
+{
+    for (const auto &listener : bml_listeners_sockets) {
+        if (listener.map_updates) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::set<std::string> db::pop_bml_nw_map_changed_nodes()
+{
+    std::set<std::string> changed_nodes;
+    changed_nodes.swap(bml_nw_map_changed_nodes);
+    return changed_nodes;
+}
+
+void db::add_bml_nw_map_request(Socket *sd, uint16_t id)
+{
+    if (sd) {
+        bml_nw_map_requests.push_back({sd, id});
+    }
+}
+
+std::vector<db::sBmlNwMapRequest> db::pop_bml_nw_map_requests()
+{
+    std::vector<sBmlNwMapRequest> requests;
+    requests.swap(bml_nw_map_requests);
+    return requests;
+}
+
+void db::add_bml_stats_update(const std::set<std::string> &valid_hostaps)
+{
+    bml_stats_updates.push_back(valid_hostaps);
+}
+
+std::vector<std::set<std::string>> db::pop_bml_stats_updates()
+{
+    std::vector<std::set<std::string>> updates;
+    updates.swap(bml_stats_updates);
+    return updates;
+}
+
 bool db::is_bml_listener_exist()
 {
     bool listener_exist;
@@ -2418,6 +2532,22 @@ bool db::set_node_stats_info(std::string mac, beerocks_message::sStaStatsParams
     if (!n) {
         return false;
     }
+    set_node_stats_info(n, params);
+    return true;
+}
+
+bool db::set_node_stats_info(const sMacAddr &mac, beerocks_message::sStaStatsParams *params)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        return false;
+    }
+    set_node_stats_info(n, params);
+    return true;
+}
+
+void db::set_node_stats_info(std::shared_ptr<node> n, beerocks_message::sStaStatsParams *params)
+{
     if (params == nullptr) { // clear stats
         n->clear_node_stats_info();
     } else {
@@ -2435,7 +2565,6 @@ bool db::set_node_stats_info(std::string mac, beerocks_message::sStaStatsParams
         p->rx_rssi           = params->rx_rssi;
         p->timestamp         = std::chrono::steady_clock::now();
     }
-    return true;
 }
 
 void db::clear_node_stats_info(std::string mac) { set_node_stats_info(mac, nullptr); }
@@ -2789,11 +2918,14 @@ bool db::set_node_channel_bw(const std::string &mac, int channel, beerocks::eWiF
         LOG(ERROR) << "frequency type unknown, channel=" << int(channel);
     }
 
+    bml_nw_map_node_changed(n);
+
     auto children = get_node_children(n);
     for (auto child : children) {
         child->channel                     = channel;
         child->bandwidth                   = bw;
         child->channel_ext_above_secondary = channel_ext_above_secondary;
+        bml_nw_map_node_changed(child);
     }
     return true;
 }
@@ -3063,6 +3195,18 @@ std::shared_ptr<node> db::get_node(std::string key)
         return last_accessed_node;
     }
 
+    uint64_t mac_key;
+    if (mac_key_from_string(key, mac_key)) {
+        auto it = node_index.find(mac_key);
+        if (it == node_index.end()) {
+            return nullptr;
+        }
+        last_accessed_node_mac = key;
+        last_accessed_node     = it->second;
+        return it->second;
+    }
+
+    // <al_mac>_<ruid> keys
     for (int i = 0; i < HIERARCHY_MAX; i++) {
         auto it = nodes[i].find(key);
         if (it != nodes[i].end()) {
@@ -3074,31 +3218,78 @@ std::shared_ptr<node> db::get_node(std::string key)
     return nullptr;
 }
 
-std::set<std::shared_ptr<node>> db::get_node_subtree(std::shared_ptr<node> n)
+void db::bml_nw_map_node_changed(std::shared_ptr<node> n)
 {
-    std::set<std::shared_ptr<node>> subtree;
+    if (!n || bml_listeners_sockets.empty() || !is_bml_nw_map_listener_exist()) {
+        return;
+    }
+    bml_nw_map_changed_nodes.insert(n->mac);
+    // radios are reported as part of their parent IRE/GW node
+    if (n->get_type() == beerocks::TYPE_SLAVE && !n->parent_mac.empty()) {
+        bml_nw_map_changed_nodes.insert(n->parent_mac);
+    }
+}
 
-    if (!n) {
-        LOG(ERROR) << "node is nullptr!";
-        return subtree;
+std::shared_ptr<node> db::get_node(const sMacAddr &mac)
+{
+    auto it = node_index.find(net::network_utils::mac_to_uint64(mac.oct));
+    if (it == node_index.end()) {
+        return nullptr;
     }
+    return it->second;
+}
 
-    int i = get_node_hierarchy(n) + 1;
+void db::index_node(const std::string &key, std::shared_ptr<node> n)
+{
+    uint64_t mac_key;
+    if (mac_key_from_string(key, mac_key)) {
+        node_index.insert(std::make_pair(mac_key, n));
+    }
+}
 
-    if (i >= HIERARCHY_MAX) {
-        return subtree;
+void db::unindex_node(const std::string &key)
+{
+    uint64_t mac_key;
+    if (mac_key_from_string(key, mac_key)) {
+        node_index.erase(mac_key);
     }
+}
 
-    for (auto &node_element : nodes[i]) {
-        if (node_element.first == node_element.second->mac) {
-            auto subtree_node = node_element.second;
-            if (subtree_node->parent_mac == n->mac) {
-                subtree.insert(subtree_node);
-                std::set<std::shared_ptr<node>> sub_subtree = get_node_subtree(subtree_node);
-                subtree.insert(sub_subtree.begin(), sub_subtree.end());
-            }
+void db::index_node_attributes(std::shared_ptr<node> n)
+{
+    auto type = n->get_type();
+    if (type < beerocks::TYPE_MAX) {
+        nodes_by_type[type].insert(n);
+    }
+    node_children[n->parent_mac].insert(n);
+}
+
+void db::unindex_node_attributes(std::shared_ptr<node> n)
+{
+    auto type = n->get_type();
+    if (type < beerocks::TYPE_MAX) {
+        nodes_by_type[type].erase(n);
+    }
+    auto it = node_children.find(n->parent_mac);
+    if (it != node_children.end()) {
+        it->second.erase(n);
+        if (it->second.empty()) {
+            node_children.erase(it);
         }
     }
+}
+
+std::set<std::shared_ptr<node>> db::get_node_subtree(std::shared_ptr<node> n)
+{
+    std::set<std::shared_ptr<node>> subtree;
+
+    if (!n) {
+        LOG(ERROR) << "node is nullptr!";
+        return subtree;
+    }
+
+    auto visit = [&](const std::shared_ptr<node> &s) { subtree.insert(s); };
+    visit_node_subtree(n, visit);
     return subtree;
 }
 
@@ -3112,23 +3303,8 @@ std::set<std::shared_ptr<node>> db::get_node_children(std::shared_ptr<node> n, i
         return children;
     }
 
-    auto bssids = get_hostap_vaps_bssids(n->mac);
-    bssids.insert(n->mac);
-
-    int hierarchy = get_node_hierarchy(n) + 1;
-
-    if (hierarchy >= 0 && hierarchy < HIERARCHY_MAX) {
-        for (auto &node_element : nodes[hierarchy]) {
-            auto child = node_element.second;
-            if ((child->mac == node_element.first) &&
-                (bssids.find(child->parent_mac) != bssids.end() &&
-                 (type == beerocks::TYPE_ANY || child->get_type() == type) &&
-                 (state == beerocks::STATE_ANY || child->state == state) &&
-                 (parent_mac.empty() || child->parent_mac == parent_mac))) {
-                children.insert(child);
-            }
-        }
-    }
+    auto visit = [&](const std::shared_ptr<node> &c) { children.insert(c); };
+    visit_node_children(n, type, state, parent_mac, visit);
     return children;
 }
 
@@ -3141,23 +3317,30 @@ void db::adjust_subtree_hierarchy(std::shared_ptr<node> n)
 
     int hierarchy = get_node_hierarchy(n);
 
-    for (int i = 0; i < HIERARCHY_MAX; ++i) {
-        for (auto it = nodes[i].begin(); it != nodes[i].end();) {
-            auto subtree_node = it->second;
-            if (subtree_node->parent_mac == n->mac) {
-                int new_hierarchy = hierarchy + 1;
-                if (new_hierarchy >= HIERARCHY_MAX) {
-                    LOG(ERROR) << "new hierarchy is too high!";
-                    return;
-                }
-                it = nodes[i].erase(it);
-                nodes[new_hierarchy].insert(std::make_pair(subtree_node->mac, subtree_node));
-                subtree_node->hierarchy = new_hierarchy;
-                adjust_subtree_hierarchy(subtree_node);
-            } else {
-                ++it;
+    auto children = node_children.find(n->mac);
+    if (children == node_children.end()) {
+        return;
+    }
+    for (const auto &subtree_node : children->second) {
+        int new_hierarchy = hierarchy + 1;
+        if (new_hierarchy >= HIERARCHY_MAX) {
+            LOG(ERROR) << "new hierarchy is too high!";
+            return;
+        }
+        // a radio is also keyed by <al_mac>_<ruid>, move both keys
+        auto ruid_key = get_node_key(subtree_node->parent_mac, subtree_node->radio_identifier);
+        if (subtree_node->hierarchy >= 0 && subtree_node->hierarchy < HIERARCHY_MAX) {
+            nodes[subtree_node->hierarchy].erase(subtree_node->mac);
+            if (!ruid_key.empty()) {
+                nodes[subtree_node->hierarchy].erase(ruid_key);
             }
         }
+        nodes[new_hierarchy].insert(std::make_pair(subtree_node->mac, subtree_node));
+        if (!ruid_key.empty()) {
+            nodes[new_hierarchy].insert(std::make_pair(ruid_key, subtree_node));
+        }
+        subtree_node->hierarchy = new_hierarchy;
+        adjust_subtree_hierarchy(subtree_node);
     }
 }
 
@@ -3169,8 +3352,13 @@ void db::adjust_subtree_hierarchy(std::set<std::shared_ptr<node>> subtree, int o
             LOG(ERROR) << "invalid new_hierarchy=" << new_hierarchy << " for node " << s->mac;
             continue;
         }
+        auto ruid_key = get_node_key(s->parent_mac, s->radio_identifier);
         nodes[s->hierarchy].erase(s->mac);
         nodes[new_hierarchy].insert({s->mac, s});
+        if (!ruid_key.empty()) {
+            nodes[s->hierarchy].erase(ruid_key);
+            nodes[new_hierarchy].insert({ruid_key, s});
+        }
         s->hierarchy = new_hierarchy;
     }
 }
@@ -13,9 +13,11 @@
 
 #include <beerocks/bcl/beerocks_defines.h>
 #include <beerocks/bcl/beerocks_logging.h>
+#include <tlvf/common/sMacAddr.h>
 
 #include <mutex>
 #include <queue>
+#include <unordered_set>
 
 namespace son {
 class db {
@@ -24,6 +26,12 @@ class db {
         * none of the functions are thread-safe
         * code that uses database should be wrapped with calls 
         * to lock() and unlock()
+        *
+        * the master thread holds the lock for its whole loop iteration except for select(),
+        * so other threads must not use the database for long operations. read-only queries
+        * which may take long (BML network map dumps and statistics) are queued here and served
+        * by the master query worker from records copied out of the database at the end of the
+        * iteration, see master_thread::dispatch_bml_queries()
         */
 
     typedef struct {
@@ -33,6 +41,11 @@ class db {
         bool events_updates;
     } sBmlListener;
 
+    typedef struct {
+        Socket *sd;
+        uint16_t id;
+    } sBmlNwMapRequest;
+
 public:
     // VAPs info list type
     typedef std::list<std::shared_ptr<beerocks_message::sConfigVapInfo>> vaps_list_t;
@@ -129,6 +142,7 @@ public:
 
     // General set/get
     bool has_node(std::string mac);
+    bool has_node(const sMacAddr &mac);
 
     bool add_virtual_node(std::string mac, std::string real_node_mac);
     bool add_node(std::string mac, std::string parent_mac = std::string(),
@@ -138,6 +152,7 @@ public:
 
     bool set_node_type(std::string mac, beerocks::eType type);
     beerocks::eType get_node_type(std::string mac);
+    beerocks::eType get_node_type(const sMacAddr &mac);
 
     bool set_local_slave_mac(std::string mac);
     std::string get_local_slave_mac();
@@ -160,6 +175,7 @@ public:
 
     bool set_node_state(std::string mac, beerocks::eNodeState state);
     beerocks::eNodeState get_node_state(std::string mac);
+    beerocks::eNodeState get_node_state(const sMacAddr &mac);
 
     bool set_node_operational_state(std::string bridge_mac, bool operational);
     int8_t get_node_operational_state(std::string bridge_mac);
@@ -196,8 +212,10 @@ public:
     bool is_ap_out_of_band(std::string mac, std::string sta_mac);
 
     bool is_node_wireless(std::string mac);
+    bool is_node_wireless(const sMacAddr &mac);
 
     Socket *get_node_socket(std::string mac);
+    Socket *get_node_socket(const sMacAddr &mac);
     bool set_node_socket(std::string mac, Socket *socket);
 
     bool disconnected_slave_mac_queue_empty();
@@ -218,6 +236,7 @@ public:
     std::string get_gw_mac();
     std::set<std::string> get_node_subtree(std::string mac);
     std::string get_node_parent(std::string mac);
+    std::string get_node_parent(const sMacAddr &mac);
 
     std::string get_node_parent_hostap(std::string mac);
     std::string get_node_previous_parent(std::string mac);
@@ -226,8 +245,25 @@ public:
     std::set<std::string> get_node_siblings(std::string mac, int type = beerocks::TYPE_ANY);
     std::set<std::string> get_node_children(std::string mac, int type = beerocks::TYPE_ANY,
                                             int state = beerocks::STATE_ANY);
+    size_t count_node_children(const std::string &mac, int type = beerocks::TYPE_ANY,
+                               int state = beerocks::STATE_ANY);
     std::string get_node_key(const std::string &al_mac, const std::string &ruid);
 
+    //
+    // Visitor variants of the set returning queries, fn(const std::string &mac) is called for
+    // each result without building a set (in no particular order).
+    // fn must not add or remove nodes nor change the type, state or parent of a node,
+    // collect the macs with the set returning query when that is needed.
+    //
+    template <typename F> void for_each_node(int type, F fn);
+    template <typename F> void for_each_active_hostap(F fn);
+    template <typename F> void for_each_node_in_hierarchy(int hierarchy, int type, F fn);
+    template <typename F> void for_each_node_in_subtree(const std::string &mac, F fn);
+    template <typename F> void for_each_node_sibling(const std::string &mac, int type, F fn);
+    template <typename F>
+    void for_each_node_child(const std::string &mac, int type, int state, F fn);
+    template <typename F> void for_each_hostap_vap_bssid(const std::string &mac, F fn);
+
     //
     // Capabilities
     //
@@ -294,6 +330,7 @@ public:
     std::string get_hostap_vap_with_ssid(const std::string &mac, const std::string &ssid);
     std::string get_hostap_vap_mac(const std::string &mac, const int vap_id);
     std::string get_node_parent_radio(const std::string &mac);
+    std::string get_node_parent_radio(const sMacAddr &mac);
     int8_t get_hostap_vap_id(const std::string &mac);
 
     bool get_hostap_advertise_ssid_flag(std::string mac);
@@ -374,6 +411,20 @@ public:
     bool set_bml_events_update_enable(Socket *sd, bool update_enable);
     Socket *get_bml_socket_at(int idx);
     bool is_bml_listener_exist();
+    bool is_bml_nw_map_listener_exist();
+    /*
+     * macs of the nodes which were modified since the last call,
+     * only tracked while there are network map update listeners
+     */
+    std::set<std::string> pop_bml_nw_map_changed_nodes();
+    /*
+     * queries served by the master query worker once the current master loop iteration is done,
+     * the pending requests of a socket are dropped by remove_bml_socket()
+     */
+    void add_bml_nw_map_request(Socket *sd, uint16_t id);
+    std::vector<sBmlNwMapRequest> pop_bml_nw_map_requests();
+    void add_bml_stats_update(const std::set<std::string> &valid_hostaps);
+    std::vector<std::set<std::string>> pop_bml_stats_updates();
 
     void set_vap_list(std::shared_ptr<vaps_list_t> vaps_list);
     const std::shared_ptr<vaps_list_t> get_vap_list();
@@ -406,6 +457,7 @@ public:
     bool set_hostap_stats_info(std::string mac, beerocks_message::sApStatsParams *params);
     void clear_hostap_stats_info(std::string mac);
     bool set_node_stats_info(std::string mac, beerocks_message::sStaStatsParams *params);
+    bool set_node_stats_info(const sMacAddr &mac, beerocks_message::sStaStatsParams *params);
     void clear_node_stats_info(std::string mac);
 
     int get_hostap_stats_measurement_duration(std::string mac);
@@ -594,6 +646,12 @@ public:
 private:
     std::string local_slave_mac;
     std::shared_ptr<node> get_node(std::string key); //key can be <mac> or <al_mac>_<ruid>
+    std::shared_ptr<node> get_node(const sMacAddr &mac);
+    void index_node(const std::string &key, std::shared_ptr<node> n);
+    void unindex_node(const std::string &key);
+    void index_node_attributes(std::shared_ptr<node> n);
+    void unindex_node_attributes(std::shared_ptr<node> n);
+    void set_node_stats_info(std::shared_ptr<node> n, beerocks_message::sStaStatsParams *params);
     int get_node_hierarchy(std::shared_ptr<node> n);
     std::set<std::shared_ptr<node>> get_node_subtree(std::shared_ptr<node> n);
     void adjust_subtree_hierarchy(std::shared_ptr<node> n);
@@ -602,7 +660,12 @@ private:
                                                       int type               = beerocks::TYPE_ANY,
                                                       int state              = beerocks::STATE_ANY,
                                                       std::string parent_mac = std::string());
+    template <typename F>
+    void visit_node_children(const std::shared_ptr<node> &n, int type, int state,
+                             const std::string &parent_mac, F &fn);
+    template <typename F> void visit_node_subtree(const std::shared_ptr<node> &n, F &fn);
     int get_node_bw_int(std::shared_ptr<node> &n);
+    void bml_nw_map_node_changed(std::shared_ptr<node> n);
 
     void rewind();
     bool get_next_node(std::shared_ptr<node> &n, int &hierarchy);
@@ -621,6 +684,23 @@ private:
 
     std::unordered_map<std::string, std::shared_ptr<node>> nodes[beerocks::HIERARCHY_MAX];
 
+    /*
+     * flat index of all the nodes keyed by their binary mac (network_utils::mac_to_uint64),
+     * the hierarchy is kept in node::hierarchy.
+     * <al_mac>_<ruid> keys are not macs and are only found in nodes[]
+     */
+    std::unordered_map<uint64_t, std::shared_ptr<node>> node_index;
+
+    /*
+     * secondary indices of the nodes by type and by parent mac, so queries over a type or over
+     * the children of a node do not scan the whole db.
+     * every node is indexed once, regardless of the number of keys it has in nodes[].
+     * the indexed node attributes must only be changed between unindex_node_attributes() and
+     * index_node_attributes()
+     */
+    std::unordered_set<std::shared_ptr<node>> nodes_by_type[beerocks::TYPE_MAX];
+    std::unordered_map<std::string, std::unordered_set<std::shared_ptr<node>>> node_children;
+
     std::queue<std::string> disconnected_slave_mac_queue;
 
     int slaves_stop_on_failure_attempts = 0;
@@ -635,6 +715,9 @@ private:
 
     std::vector<Socket *> cli_debug_sockets;
     std::vector<sBmlListener> bml_listeners_sockets;
+    std::set<std::string> bml_nw_map_changed_nodes;
+    std::vector<sBmlNwMapRequest> bml_nw_map_requests;
+    std::vector<std::set<std::string>> bml_stats_updates;
 
     beerocks::logging &logger;
 
@@ -645,6 +728,174 @@ private:
     std::shared_ptr<vaps_list_t> m_vap_list;
 };
 
+template <typename F> void db::for_each_node(int type, F fn)
+{
+    for (int t = 0; t < beerocks::TYPE_MAX; t++) {
+        if (type >= 0 && t != type) {
+            continue;
+        }
+        for (const auto &n : nodes_by_type[t]) {
+            fn(n->mac);
+        }
+    }
+}
+
+template <typename F> void db::for_each_active_hostap(F fn)
+{
+    for (const auto &n : nodes_by_type[beerocks::TYPE_SLAVE]) {
+        if (n->hostap != nullptr && n->state == beerocks::STATE_CONNECTED && n->hostap->active) {
+            fn(n->mac);
+        }
+    }
+}
+
+template <typename F> void db::for_each_node_in_hierarchy(int hierarchy, int type, F fn)
+{
+    if (hierarchy < 0 || hierarchy >= beerocks::HIERARCHY_MAX) {
+        LOG(ERROR) << "invalid hierarchy";
+        return;
+    }
+
+    if (type >= 0 && type < beerocks::TYPE_MAX) {
+        for (const auto &n : nodes_by_type[type]) {
+            if (n->hierarchy == hierarchy) {
+                fn(n->mac);
+            }
+        }
+        return;
+    }
+
+    for (const auto &kv : nodes[hierarchy]) {
+        if ((type < 0 || kv.second->get_type() == type) && (kv.second->mac == kv.first)) {
+            fn(kv.first);
+        }
+    }
+}
+
+template <typename F> void db::for_each_node_in_subtree(const std::string &mac, F fn)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << "node " << mac << " does not exist!";
+        return;
+    }
+    auto visit = [&](const std::shared_ptr<node> &s) { fn(s->mac); };
+    visit_node_subtree(n, visit);
+}
+
+template <typename F> void db::for_each_node_sibling(const std::string &mac, int type, F fn)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist";
+        return;
+    }
+
+    auto parent = get_node(n->parent_mac);
+    if (!parent) {
+        LOG(ERROR) << "parent for node " << mac << " does not exist";
+        return;
+    }
+
+    int hierarchy = get_node_hierarchy(parent) + 1;
+    auto children = node_children.find(parent->mac);
+    if (children == node_children.end()) {
+        return;
+    }
+    for (const auto &sib : children->second) {
+        if ((sib->hierarchy == hierarchy) && (mac != sib->mac) &&
+            (type == beerocks::TYPE_ANY || sib->get_type() == type)) {
+            fn(sib->mac);
+        }
+    }
+}
+
+template <typename F>
+void db::for_each_node_child(const std::string &mac, int type, int state, F fn)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist";
+        return;
+    }
+
+    // a node found by its <al_mac>_<ruid> key only has the children connected to that key
+    auto visit = [&](const std::shared_ptr<node> &c) { fn(c->mac); };
+    visit_node_children(n, type, state, (n->mac == mac) ? std::string() : mac, visit);
+}
+
+template <typename F> void db::for_each_hostap_vap_bssid(const std::string &mac, F fn)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist!";
+        return;
+    }
+
+    // Only slaves have vap's
+    if (n->get_type() != beerocks::TYPE_SLAVE || n->hostap == nullptr) {
+        return;
+    }
+    for (const auto &vap : n->hostap->vaps_info) {
+        fn(vap.second.mac);
+    }
+}
+
+template <typename F>
+void db::visit_node_children(const std::shared_ptr<node> &n, int type, int state,
+                             const std::string &parent_mac, F &fn)
+{
+    int hierarchy = get_node_hierarchy(n) + 1;
+
+    // children of a hostap are connected to one of its vaps
+    auto visit_bssid = [&](const std::string &bssid) {
+        if (!parent_mac.empty() && bssid != parent_mac) {
+            return;
+        }
+        auto children = node_children.find(bssid);
+        if (children == node_children.end()) {
+            return;
+        }
+        for (const auto &child : children->second) {
+            if ((child->hierarchy == hierarchy) &&
+                (type == beerocks::TYPE_ANY || child->get_type() == type) &&
+                (state == beerocks::STATE_ANY || child->state == state)) {
+                fn(child);
+            }
+        }
+    };
+
+    visit_bssid(n->mac);
+    if (n->get_type() == beerocks::TYPE_SLAVE && n->hostap != nullptr) {
+        for (const auto &vap : n->hostap->vaps_info) {
+            if (vap.second.mac != n->mac) {
+                visit_bssid(vap.second.mac);
+            }
+        }
+    }
+}
+
+template <typename F> void db::visit_node_subtree(const std::shared_ptr<node> &n, F &fn)
+{
+    int i = get_node_hierarchy(n) + 1;
+
+    if (i >= beerocks::HIERARCHY_MAX) {
+        return;
+    }
+
+    auto children = node_children.find(n->mac);
+    if (children == node_children.end()) {
+        return;
+    }
+    for (const auto &subtree_node : children->second) {
+        if (subtree_node->hierarchy != i) {
+            continue;
+        }
+        fn(subtree_node);
+        visit_node_subtree(subtree_node, fn);
+    }
+}
+
 } // namespace son
 
 #endif
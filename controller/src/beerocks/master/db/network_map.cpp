@@ -18,127 +18,206 @@
 
 #include <bml_defs.h>
 
-#include <unordered_set>
-
 using namespace beerocks;
 using namespace net;
 using namespace son;
 
-void network_map::send_bml_network_map_message(db &database, Socket *sd,
-                                               ieee1905_1::CmduMessageTx &cmdu_tx, uint16_t id)
+// appends the records from idx on to the buffer of the message while they fit in cmdu_tx, idx is
+// advanced past the appended records, returns false if not even a single record fits
+template <typename T>
+static bool append_bml_records(ieee1905_1::CmduMessageTx &cmdu_tx, std::shared_ptr<T> message,
+                               uint32_t &num_of_records,
+                               const std::vector<std::vector<uint8_t>> &records, size_t &idx)
 {
-    auto response =
-        message_com::create_vs_message<beerocks_message::cACTION_BML_NW_MAP_RESPONSE>(cmdu_tx, id);
-    if (response == nullptr) {
-        LOG(ERROR) << "Failed building ACTION_BML_NW_MAP_BRIDGE_RESPONSE message!";
-        return;
+    const size_t tlvEndSize = ieee1905_1::tlvEndOfMessage::get_initial_size();
+
+    for (; idx < records.size(); idx++) {
+        std::ptrdiff_t size_left =
+            cmdu_tx.getMessageBuffLength() - cmdu_tx.getMessageLength() - tlvEndSize;
+        std::ptrdiff_t record_len = records[idx].size();
+        if (record_len > size_left) {
+            if (num_of_records == 0) {
+                LOG(ERROR) << "node size is bigger than buffer size";
+                return false;
+            }
+            break;
+        }
+        if (!message->alloc_buffer(record_len)) {
+            LOG(ERROR) << "Failed allocating buffer!";
+            return false;
+        }
+        std::copy(records[idx].begin(), records[idx].end(),
+                  (uint8_t *)message->buffer(0) + message->buffer_size() - record_len);
+        num_of_records++;
     }
+    return true;
+}
 
-    auto beerocks_header = message_com::get_vs_class_header(cmdu_tx);
-
-    if (!beerocks_header) {
-        LOG(ERROR) << "Failed getting beerocks_header!";
-        return;
+// GW and IRE records carry the data of their radios
+static std::ptrdiff_t get_bml_node_len(beerocks::eType type)
+{
+    if (type == beerocks::TYPE_GW || type == beerocks::TYPE_IRE) {
+        return sizeof(BML_NODE);
     }
+    return sizeof(BML_NODE) - sizeof(BML_NODE::N_DATA::N_GW_IRE);
+}
 
-    beerocks_header->last() = 0;
-
-    uint8_t *data_start = nullptr;
-    // std::ptrdiff_t size=0, size_left=0, node_len=0;
-    const size_t tlvEndSize     = ieee1905_1::tlvEndOfMessage::get_initial_size();
-    const size_t gwIreNodeSize  = sizeof(BML_NODE);
-    const size_t clientNodeSize = sizeof(BML_NODE) - sizeof(BML_NODE::N_DATA::N_GW_IRE);
-
-    std::ptrdiff_t size = 0, size_left = 0, node_len = 0;
-    uint32_t &num_of_nodes = response->node_num();
-    num_of_nodes           = 0;
+void network_map::get_bml_nw_map_data(db &database, std::vector<sBmlNodeData> &nodes)
+{
+    nodes.clear();
 
     database.rewind();
-    bool last          = false;
-    bool get_next_node = true;
-    beerocks::eType n_type;
+    bool last = false;
     std::shared_ptr<node> n;
+    while (!last) {
+        n    = nullptr;
+        last = database.get_next_node(n);
+        if (n == nullptr) {
+            continue;
+        }
 
-    // because of virtual nodes (vap nodes) are poiting to the radio node,
-    // we want to save the in a list in order to not count them multiple times as the same mac.
-    std::unordered_set<std::string> ap_list;
+        // only connected GW/IRE/client nodes are part of the map, virtual vap nodes point to
+        // their radio node so they are skipped as well
+        auto n_type = n->get_type();
+        if ((n->state != beerocks::STATE_CONNECTED &&
+             n->state != beerocks::STATE_CONNECTED_IP_UNKNOWN) ||
+            (n_type != beerocks::TYPE_CLIENT && n_type != beerocks::TYPE_IRE &&
+             n_type != beerocks::TYPE_GW)) {
+            continue;
+        }
 
-    while (!last || !get_next_node) {
-        if (get_next_node) {
-            n    = nullptr;
-            last = database.get_next_node(n);
+        sBmlNodeData data;
+        if (get_bml_node_data(database, n, data)) {
+            nodes.push_back(std::move(data));
         }
-        // LOG(DEBUG) << "last = " << last << " get_next_node=" << get_next_node;
+    }
+}
 
-        if (n == nullptr) {
-            // LOG(DEBUG) << "n == nullptr";
+void network_map::get_bml_nw_map_records(const std::vector<sBmlNodeData> &nodes,
+                                         std::vector<std::vector<uint8_t>> &records)
+{
+    records.clear();
+    records.reserve(nodes.size());
+
+    for (const auto &data : nodes) {
+        std::vector<uint8_t> record(get_bml_node_len(data.type));
+        if (fill_bml_node_data(data, record.data(), record.size()) == 0) {
             continue;
         }
+        records.push_back(std::move(record));
+    }
+}
+
+void network_map::send_bml_network_map_message(ieee1905_1::CmduMessageTx &cmdu_tx, uint16_t id,
+                                               const std::vector<std::vector<uint8_t>> &records,
+                                               const send_message_t &send_message)
+{
+    size_t idx = 0;
+
+    do {
+        auto response = message_com::create_vs_message<
+            beerocks_message::cACTION_BML_NW_MAP_RESPONSE>(cmdu_tx, id);
+        if (response == nullptr) {
+            LOG(ERROR) << "Failed building ACTION_BML_NW_MAP_RESPONSE message!";
+            return;
+        }
 
-        // skip virtual vap nodes
-        if (n->get_type() == beerocks::TYPE_SLAVE) {
-            if (ap_list.find(n->mac) == ap_list.end()) {
-                // radio/main vap
-                ap_list.insert(n->mac);
-            } else {
-                // vap node
-                continue;
-            }
+        auto beerocks_header = message_com::get_vs_class_header(cmdu_tx);
+        if (!beerocks_header) {
+            LOG(ERROR) << "Failed getting beerocks_header!";
+            return;
         }
-        size_left = cmdu_tx.getMessageBuffLength() - cmdu_tx.getMessageLength() - tlvEndSize;
 
-        // LOG(DEBUG) << "num_of_nodes = " << num_of_nodes << ", size = " << int(size) << ", size_left = " << int(size_left);
+        response->node_num() = 0;
+        if (!append_bml_records(cmdu_tx, response, response->node_num(), records, idx)) {
+            return;
+        }
 
-        n_type = n->get_type();
-        if ((n->state == beerocks::STATE_CONNECTED ||
+        beerocks_header->last() = (idx == records.size()) ? 1 : 0;
+        send_message(cmdu_tx);
+    } while (idx < records.size());
+}
+
+bool network_map::get_bml_nw_map_node_record(db &database, const std::string &mac,
+                                             std::vector<uint8_t> &record,
+                                             bool force_client_disconnect)
+{
+    record.clear();
+
+    auto n = database.get_node(mac);
+    if (!n) {
+        return false;
+    }
+
+    auto n_type              = n->get_type();
+    std::ptrdiff_t node_len = get_bml_node_len(n_type);
+
+    record.resize(node_len);
+    if (fill_bml_node_data(database, n, record.data(), node_len, force_client_disconnect) == 0) {
+        record.clear();
+        return false;
+    }
+
+    return (!force_client_disconnect &&
+            (n->state == beerocks::STATE_CONNECTED ||
              n->state == beerocks::STATE_CONNECTED_IP_UNKNOWN) &&
             (n_type == beerocks::TYPE_CLIENT || n_type == beerocks::TYPE_IRE ||
-             n_type == beerocks::TYPE_GW)) {
+             n_type == beerocks::TYPE_GW));
+}
 
-            if (n_type == beerocks::TYPE_CLIENT) {
-                node_len = clientNodeSize;
-            } else {
-                node_len = gwIreNodeSize;
-            }
+void network_map::get_bml_nw_map_node_records(
+    db &database, std::unordered_map<std::string, std::vector<uint8_t>> &records)
+{
+    records.clear();
 
-            if (node_len > size_left && num_of_nodes == 0) {
-                LOG(ERROR) << "node size is bigger than buffer size";
-                return;
-            } else if (node_len > size_left) {
-                message_com::send_cmdu(sd, cmdu_tx);
-
-                get_next_node = false;
-                response =
-                    message_com::create_vs_message<beerocks_message::cACTION_BML_NW_MAP_RESPONSE>(
-                        cmdu_tx, id);
-                beerocks_header         = message_com::get_vs_class_header(cmdu_tx);
-                beerocks_header->last() = 0;
-                num_of_nodes            = response->node_num(); // prepare for next message
-                num_of_nodes            = 0;
-                data_start              = nullptr;
-                size                    = 0;
-            } else {
-                if (!response->alloc_buffer(node_len)) {
-                    LOG(ERROR) << "Failed allocating buffer!";
-                    return;
-                }
+    database.rewind();
+    bool last = false;
+    std::shared_ptr<node> n;
+    while (!last) {
+        n    = nullptr;
+        last = database.get_next_node(n);
+        // virtual vap nodes point to their radio node, which is not part of the map anyway
+        if (n == nullptr || records.find(n->mac) != records.end()) {
+            continue;
+        }
+        std::vector<uint8_t> record;
+        if (get_bml_nw_map_node_record(database, n->mac, record)) {
+            records[n->mac] = std::move(record);
+        }
+    }
+}
 
-                if (data_start == nullptr) {
-                    data_start = (uint8_t *)response->buffer(0);
-                }
+void network_map::send_bml_nw_map_update_message(ieee1905_1::CmduMessageTx &cmdu_tx,
+                                                 std::vector<Socket *> bml_listeners,
+                                                 const std::vector<std::vector<uint8_t>> &records,
+                                                 uint32_t &sequence_num, bool snapshot)
+{
+    size_t idx = 0;
+
+    do {
+        auto update =
+            message_com::create_vs_message<beerocks_message::cACTION_BML_NW_MAP_UPDATE>(cmdu_tx);
+        if (update == nullptr) {
+            LOG(ERROR) << "Failed building ACTION_BML_NW_MAP_UPDATE message!";
+            return;
+        }
 
-                fill_bml_node_data(database, n, data_start + size, size_left);
+        auto beerocks_header = message_com::get_vs_class_header(cmdu_tx);
+        if (!beerocks_header) {
+            LOG(ERROR) << "Failed getting beerocks_header!";
+            return;
+        }
 
-                num_of_nodes++;
-                size += node_len;
-                get_next_node = true;
-            }
+        update->sequence_num() = snapshot ? sequence_num : ++sequence_num;
+        update->snapshot()     = snapshot;
+        update->node_num()     = 0;
+        if (!append_bml_records(cmdu_tx, update, update->node_num(), records, idx)) {
+            return;
         }
-    }
 
-    beerocks_header->last() = 1;
-    message_com::send_cmdu(sd, cmdu_tx);
-    //LOG(DEBUG) << "sending message, last=1";
+        beerocks_header->last() = (idx == records.size()) ? 1 : 0;
+        send_bml_event_to_listeners(cmdu_tx, bml_listeners);
+    } while (idx < records.size());
 }
 
 std::ptrdiff_t network_map::fill_bml_node_data(db &database, std::string node_mac,
@@ -158,25 +237,93 @@ std::ptrdiff_t network_map::fill_bml_node_data(db &database, std::shared_ptr<nod
                                                uint8_t *tx_buffer, std::ptrdiff_t &buffer_size,
                                                bool force_client_disconnect)
 {
-    auto node = (BML_NODE *)tx_buffer;
+    sBmlNodeData data;
+    if (!get_bml_node_data(database, n, data, force_client_disconnect)) {
+        return 0;
+    }
+    return fill_bml_node_data(data, tx_buffer, buffer_size);
+}
 
+bool network_map::get_bml_node_data(db &database, std::shared_ptr<node> n, sBmlNodeData &data,
+                                    bool force_client_disconnect)
+{
     if (n == nullptr) {
         LOG(ERROR) << " n == nullptr !!!";
-        return 0;
+        return false;
     }
 
+    auto n_type   = n->get_type();
+    data.type     = n_type;
+    data.platform = n->platform;
+    data.state    = force_client_disconnect ? beerocks::STATE_DISCONNECTED : n->state;
+
+    if (n_type == beerocks::TYPE_IRE &&
+        database.is_node_wireless(database.get_node_parent(n->mac))) {
+        auto parent_backhaul_mac = database.get_node_parent_backhaul(n->mac);
+        data.channel             = database.get_node_channel(parent_backhaul_mac);
+        data.bw                  = database.get_node_bw(parent_backhaul_mac);
+        data.channel_ext_above_secondary =
+            database.get_node_channel_ext_above_secondary(parent_backhaul_mac);
+    } else {
+        data.channel                     = n->channel;
+        data.bw                          = n->bandwidth;
+        data.channel_ext_above_secondary = n->channel_ext_above_secondary;
+    }
+
+    data.mac           = n->mac;
+    data.parent_bridge = database.get_node_parent_ire(n->mac);
+    if (n_type == beerocks::TYPE_CLIENT) {
+        data.parent_bssid = n->parent_mac;
+        data.rx_rssi      = database.get_load_rx_rssi(n->mac);
+    } else if (n->parent_mac != std::string()) {
+        auto n_parent = database.get_node(n->parent_mac);
+        if (n_parent) {
+            data.parent_bssid = n_parent->parent_mac;
+        }
+    }
+
+    data.ipv4 = n->ipv4;
+    data.name = n->name;
+
+    // GW/IRE specific parameters
+    if (n_type == beerocks::TYPE_GW || n_type == beerocks::TYPE_IRE) {
+        data.backhaul_mac = database.get_node_parent_backhaul(n->mac);
+        for (auto c : database.get_node_children(n, beerocks::TYPE_SLAVE)) {
+            if (c->state != beerocks::STATE_CONNECTED) {
+                continue;
+            }
+            sBmlNodeData::sRadio radio;
+            radio.mac                         = c->mac;
+            radio.iface_name                  = database.get_hostap_iface_name(c->mac);
+            radio.iface_type                  = database.get_hostap_iface_type(c->mac);
+            radio.driver_version              = database.get_hostap_driver_version(c->mac);
+            radio.channel                     = c->channel;
+            radio.cac_completed               = c->hostap->cac_completed;
+            radio.bw                          = c->bandwidth;
+            radio.channel_ext_above_secondary = c->channel_ext_above_secondary;
+            radio.ap_active                   = c->hostap->active;
+            radio.radio_identifier            = c->radio_identifier;
+            radio.vaps_info                   = c->hostap->vaps_info;
+            data.radios.push_back(std::move(radio));
+        }
+    }
+
+    return true;
+}
+
+std::ptrdiff_t network_map::fill_bml_node_data(const sBmlNodeData &data, uint8_t *tx_buffer,
+                                               std::ptrdiff_t buffer_size)
+{
+    auto node = (BML_NODE *)tx_buffer;
+
     uint8_t node_type;
-    auto n_type = n->get_type();
-    std::ptrdiff_t node_len;
+    std::ptrdiff_t node_len = get_bml_node_len(data.type);
 
-    if (n_type == beerocks::TYPE_GW) {
-        node_len  = sizeof(BML_NODE);
+    if (data.type == beerocks::TYPE_GW) {
         node_type = BML_NODE_TYPE_GW;
-    } else if (n_type == beerocks::TYPE_IRE) {
-        node_len  = sizeof(BML_NODE);
+    } else if (data.type == beerocks::TYPE_IRE) {
         node_type = BML_NODE_TYPE_IRE;
     } else {
-        node_len  = sizeof(BML_NODE) - sizeof(BML_NODE::N_DATA::N_GW_IRE);
         node_type = BML_NODE_TYPE_CLIENT;
     }
 
@@ -191,7 +338,7 @@ std::ptrdiff_t network_map::fill_bml_node_data(db &database, std::shared_ptr<nod
     node->type = node_type;
 
     // Platform
-    switch (n->platform) {
+    switch (data.platform) {
     // UGW
     case beerocks::PLATFORM_GRX_350: {
         node->platform = BML_PLATFORM_GRX_350;
@@ -207,273 +354,186 @@ std::ptrdiff_t network_map::fill_bml_node_data(db &database, std::shared_ptr<nod
     }
     }
 
-    if (force_client_disconnect) {
+    switch (data.state) {
+    case beerocks::STATE_DISCONNECTED:
         node->state = BML_NODE_STATE_DISCONNECTED;
-    } else {
-        switch (n->state) {
-        case beerocks::STATE_DISCONNECTED:
-            node->state = BML_NODE_STATE_DISCONNECTED;
-            break;
-
-        case beerocks::STATE_CONNECTING:
-            node->state = BML_NODE_STATE_CONNECTING;
-            break;
-
-        case beerocks::STATE_CONNECTED:
-            node->state = BML_NODE_STATE_CONNECTED;
-            break;
+        break;
 
-        case beerocks::STATE_CONNECTED_IP_UNKNOWN:
-            node->state = BML_NODE_STATE_CONNECTED_UNKNOWN_IP;
-            break;
+    case beerocks::STATE_CONNECTING:
+        node->state = BML_NODE_STATE_CONNECTING;
+        break;
 
-        default:
-            node->state = BML_NODE_STATE_UNKNOWN;
-        }
-    }
+    case beerocks::STATE_CONNECTED:
+        node->state = BML_NODE_STATE_CONNECTED;
+        break;
 
-    if (n_type == beerocks::TYPE_IRE &&
-        database.is_node_wireless(database.get_node_parent(n->mac))) {
-        auto parent_backhaul_mac = database.get_node_parent_backhaul(n->mac);
-        node->channel            = database.get_node_channel(parent_backhaul_mac);
-        node->bw                 = database.get_node_bw(parent_backhaul_mac);
-        node->channel_ext_above_secondary =
-            database.get_node_channel_ext_above_secondary(parent_backhaul_mac);
-    } else {
-        node->channel                     = n->channel;
-        node->bw                          = n->bandwidth;
-        node->channel_ext_above_secondary = n->channel_ext_above_secondary;
-    }
+    case beerocks::STATE_CONNECTED_IP_UNKNOWN:
+        node->state = BML_NODE_STATE_CONNECTED_UNKNOWN_IP;
+        break;
 
-    network_utils::mac_from_string(node->mac, n->mac); // if IRE->bridge, else if STA->sta mac
-    network_utils::mac_from_string(node->parent_bridge,
-                                   database.get_node_parent_ire(n->mac)); // remote bridge
-    if (n_type == beerocks::TYPE_CLIENT) {
-        network_utils::mac_from_string(node->parent_bssid, n->parent_mac); // remote radio(ap)
-        node->rx_rssi = database.get_load_rx_rssi(n->mac);
-    } else {
-        if (n->parent_mac != std::string()) {
-            auto n_parent = database.get_node(n->parent_mac);
-            if (n_parent) {
-                network_utils::mac_from_string(node->parent_bssid,
-                                               n_parent->parent_mac); // remote radio(ap)
+    default:
+        node->state = BML_NODE_STATE_UNKNOWN;
+    }
+
+    node->channel                     = data.channel;
+    node->bw                          = data.bw;
+    node->channel_ext_above_secondary = data.channel_ext_above_secondary;
+
+    network_utils::mac_from_string(node->mac, data.mac); // if IRE->bridge, else if STA->sta mac
+    network_utils::mac_from_string(node->parent_bridge, data.parent_bridge); // remote bridge
+    network_utils::mac_from_string(node->parent_bssid, data.parent_bssid);   // remote radio(ap)
+    node->rx_rssi = data.rx_rssi;
+
+    network_utils::ipv4_from_string(node->ip_v4, data.ipv4);
+    string_utils::copy_string(node->name, data.name.c_str(), sizeof(node->name));
+
+    // GW/IRE specific parameters, the other nodes' records are too short to carry them
+    if (data.type == beerocks::TYPE_GW || data.type == beerocks::TYPE_IRE) {
+        network_utils::mac_from_string(node->data.gw_ire.backhaul_mac,
+                                       data.backhaul_mac); // local parent backhaul
+        int i = 0;
+        for (const auto &radio : data.radios) {
+            if (i >= int(beerocks::utils::array_length(node->data.gw_ire.radio))) {
+                LOG(ERROR) << "exceeded size of data.gw_ire.radio[]";
+                break;
             }
-        }
-    }
-
-    network_utils::ipv4_from_string(node->ip_v4, n->ipv4);
-    string_utils::copy_string(node->name, n->name.c_str(), sizeof(node->name));
-
-    // GW/IRE specific parameters
-    if (n_type != beerocks::TYPE_CLIENT) {
-        network_utils::mac_from_string(
-            node->data.gw_ire.backhaul_mac,
-            database.get_node_parent_backhaul(n->mac)); // local parent backhaul
-        auto children = database.get_node_children(n, beerocks::TYPE_SLAVE);
-        int i         = 0;
-        for (auto c : children) {
-            if (c->state == beerocks::STATE_CONNECTED) {
-                if (i >= int(beerocks::utils::array_length(node->data.gw_ire.radio))) {
-                    LOG(ERROR) << "exceeded size of data.gw_ire.radio[]";
-                    break;
-                }
 
-                network_utils::mac_from_string(node->data.gw_ire.radio[i].radio_mac,
-                                               c->mac); // local parent backhaul
-
-                // Copy the interface name
-                string_utils::copy_string(node->data.gw_ire.radio[i].iface_name,
-                                          database.get_hostap_iface_name(c->mac).c_str(),
-                                          BML_NODE_IFACE_NAME_LEN);
-
-                // Radio Vendor
-                switch (database.get_hostap_iface_type(c->mac)) {
-                case beerocks::eIfaceType::IFACE_TYPE_WIFI_INTEL:
-                    node->data.gw_ire.radio[i].vendor = BML_WLAN_VENDOR_INTEL;
-                    break;
-                case beerocks::eIfaceType::IFACE_TYPE_WIFI_BRCM:
-                    node->data.gw_ire.radio[i].vendor = BML_WLAN_VENDOR_BROADCOM;
-                    break;
-                default:
-                    node->data.gw_ire.radio[i].vendor = BML_WLAN_VENDOR_UNKNOWN;
-                }
+            network_utils::mac_from_string(node->data.gw_ire.radio[i].radio_mac,
+                                           radio.mac); // local parent backhaul
+
+            // Copy the interface name
+            string_utils::copy_string(node->data.gw_ire.radio[i].iface_name,
+                                      radio.iface_name.c_str(), BML_NODE_IFACE_NAME_LEN);
+
+            // Radio Vendor
+            switch (radio.iface_type) {
+            case beerocks::eIfaceType::IFACE_TYPE_WIFI_INTEL:
+                node->data.gw_ire.radio[i].vendor = BML_WLAN_VENDOR_INTEL;
+                break;
+            case beerocks::eIfaceType::IFACE_TYPE_WIFI_BRCM:
+                node->data.gw_ire.radio[i].vendor = BML_WLAN_VENDOR_BROADCOM;
+                break;
+            default:
+                node->data.gw_ire.radio[i].vendor = BML_WLAN_VENDOR_UNKNOWN;
+            }
 
-                // Copy the driver version string
-                string_utils::copy_string(node->data.gw_ire.radio[i].driver_version,
-                                          database.get_hostap_driver_version(c->mac).c_str(),
-                                          BML_WLAN_DRIVER_VERSION_LEN);
-
-                node->data.gw_ire.radio[i].channel       = !c->channel ? 255 : c->channel;
-                node->data.gw_ire.radio[i].cac_completed = c->hostap->cac_completed;
-                node->data.gw_ire.radio[i].bw            = c->bandwidth;
-                node->data.gw_ire.radio[i].channel_ext_above_secondary =
-                    c->channel_ext_above_secondary;
-                node->data.gw_ire.radio[i].ap_active = c->hostap->active;
-
-                // Copy the radio identifier string
-                network_utils::mac_from_string(node->data.gw_ire.radio[i].radio_identifier,
-                                               c->radio_identifier);
-
-                for (int8_t vap_id = beerocks::IFACE_VAP_ID_MIN;
-                     vap_id < int8_t(c->hostap->vaps_info.size()); vap_id++) {
-                    const auto &vap = (c->hostap->vaps_info[vap_id]);
-                    network_utils::mac_from_string(node->data.gw_ire.radio[i].vap[vap_id].bssid,
-                                                   vap.mac);
-                    string_utils::copy_string(node->data.gw_ire.radio[i].vap[vap_id].ssid,
-                                              vap.ssid.c_str(),
-                                              sizeof(node->data.gw_ire.radio[i].vap[0].ssid));
-                    node->data.gw_ire.radio[i].vap[vap_id].backhaul_vap = vap.backhaul_vap;
+            // Copy the driver version string
+            string_utils::copy_string(node->data.gw_ire.radio[i].driver_version,
+                                      radio.driver_version.c_str(), BML_WLAN_DRIVER_VERSION_LEN);
+
+            node->data.gw_ire.radio[i].channel       = !radio.channel ? 255 : radio.channel;
+            node->data.gw_ire.radio[i].cac_completed = radio.cac_completed;
+            node->data.gw_ire.radio[i].bw            = radio.bw;
+            node->data.gw_ire.radio[i].channel_ext_above_secondary =
+                radio.channel_ext_above_secondary;
+            node->data.gw_ire.radio[i].ap_active = radio.ap_active;
+
+            // Copy the radio identifier string
+            network_utils::mac_from_string(node->data.gw_ire.radio[i].radio_identifier,
+                                           radio.radio_identifier);
+
+            for (const auto &vap : radio.vaps_info) {
+                auto vap_id = vap.first;
+                if (vap_id < beerocks::IFACE_VAP_ID_MIN ||
+                    vap_id >= int(beerocks::utils::array_length(node->data.gw_ire.radio[i].vap))) {
+                    continue;
                 }
-                ++i;
+                network_utils::mac_from_string(node->data.gw_ire.radio[i].vap[vap_id].bssid,
+                                               vap.second.mac);
+                string_utils::copy_string(node->data.gw_ire.radio[i].vap[vap_id].ssid,
+                                          vap.second.ssid.c_str(),
+                                          sizeof(node->data.gw_ire.radio[i].vap[0].ssid));
+                node->data.gw_ire.radio[i].vap[vap_id].backhaul_vap = vap.second.backhaul_vap;
             }
+            ++i;
         }
     }
     return node_len;
 }
 
-void network_map::send_bml_nodes_statistics_message_to_listeners(
-    db &database, ieee1905_1::CmduMessageTx &cmdu_tx, std::vector<Socket *> bml_listeners,
-    std::set<std::string> valid_hostaps)
+void network_map::get_bml_nodes_statistics_data(db &database,
+                                                const std::set<std::string> &valid_hostaps,
+                                                std::vector<sBmlStatsData> &stats)
 {
-    auto response =
-        message_com::create_vs_message<beerocks_message::cACTION_BML_STATS_UPDATE>(cmdu_tx);
-    if (response == nullptr) {
-        LOG(ERROR) << "Failed building ACTION_BML_STATS_UPDATE message!";
-        return;
-    }
-
-    auto beerocks_header = message_com::get_vs_class_header(cmdu_tx);
-    if (!beerocks_header) {
-        LOG(ERROR) << "Failed getting beerocks_header!";
-        return;
-    }
-    beerocks_header->last() = 0;
+    stats.clear();
 
-    // nodes iterating
-    //LOG(DEBUG) << "send_bml_nodes_statistics_message, buf_size " << int(tx_buffer_size);
-    uint8_t *data_start = nullptr;
-    std::ptrdiff_t size = 0, size_left = 0, node_len = 0;
-
-    const auto reserved_size =
-        message_com::get_vs_cmdu_size_on_buffer<beerocks_message::cACTION_BML_STATS_UPDATE>();
-
-    // Save room in the output buffer for the number of transmitted nodes
-    uint32_t &num_of_stats_bulks = response->num_of_stats_bulks();
-    num_of_stats_bulks           = 0;
-
-    //LOG(DEBUG) << "tx_buffer = " << int(tx_buffer) << ", data_start = " << int(data_start);
-
-    int get_next_node = 1;
-    beerocks::eType n_type;
-    std::shared_ptr<node> n;
-
-    // common function definition ///////////////////////////////////////////////
-    auto fill_and_send = [&](std::ptrdiff_t &size, std::ptrdiff_t &size_left,
-                             std::ptrdiff_t &node_len, const uint16_t reserved_size,
-                             uint8_t *&data_start) -> int {
-        size_left = cmdu_tx.getMessageBuffLength() - reserved_size - size;
-        //LOG(DEBUG) << "num_of_stats_bulks = " << num_of_stats_bulks << ", size = " << int(size) << ", size_left = " << int(size_left);
-
-        size_t node_size = get_bml_node_statistics_len(n);
-        response->alloc_buffer(node_size);
-
-        if (data_start == nullptr) {
-            data_start = (uint8_t *)response->buffer(0);
-        }
-
-        if (((reserved_size + size + node_size) >
-             cmdu_tx.getMessageBuffLength()) || // No more size on the buffer
-            !(node_len = fill_bml_node_statistics(database, n, data_start + size, size_left))) {
-            if (num_of_stats_bulks == 0) {
-                LOG(ERROR) << "node size is bigger than buffer size";
-                return -1;
-            }
-
-            //LOG(DEBUG) << "sending message, last=0";
-            // sending to all listeners
-            for (auto it = bml_listeners.begin(); it != bml_listeners.end(); ++it) {
-                message_com::send_cmdu(*it, cmdu_tx);
-            }
-
-            // prepare for next message
-            response =
-                message_com::create_vs_message<beerocks_message::cACTION_BML_STATS_UPDATE>(cmdu_tx);
-
-            beerocks_header         = message_com::get_vs_class_header(cmdu_tx);
-            beerocks_header->last() = 0;
-            num_of_stats_bulks      = response->num_of_stats_bulks();
-            num_of_stats_bulks      = 0;
-            get_next_node           = 0;
-            size                    = 0;
-        } else {
-            //LOG(DEBUG) << "node_len = " << int(node_len);
-            num_of_stats_bulks++;
-            size += node_len;
-            get_next_node = 1;
-        }
-        return get_next_node;
-    };
-    /////////////////////////////////////////////////////////////////////////
-
-    // nodes iterating
-    for (auto radio = valid_hostaps.begin(); radio != valid_hostaps.end();) {
-        std::string hostap_mac = *radio;
-        // LOG(DEBUG) << "radio mac = " << hostap_mac;
-        n = database.get_node(hostap_mac);
+    for (const auto &hostap_mac : valid_hostaps) {
+        auto n = database.get_node(hostap_mac);
         if (!n) {
             LOG(ERROR) << "n == nullptr";
             continue;
         }
-        n_type = n->get_type();
-        if ((n != nullptr && n->state == beerocks::STATE_CONNECTED) &&
-            (n_type == beerocks::TYPE_SLAVE)) {
+        if (n->state != beerocks::STATE_CONNECTED || n->get_type() != beerocks::TYPE_SLAVE) {
+            continue;
+        }
+        sBmlStatsData radio_stats;
+        radio_stats.type        = beerocks::TYPE_SLAVE;
+        radio_stats.mac         = n->mac;
+        radio_stats.radio_stats = *n->hostap->stats_info;
+        stats.push_back(std::move(radio_stats));
+
+        // sta's, filter clients which have not been measured yet
+        database.for_each_node_child(
+            hostap_mac, beerocks::TYPE_ANY, beerocks::STATE_CONNECTED,
+            [&](const std::string &sta_mac) {
+                auto sta = database.get_node(sta_mac);
+                if (!sta || sta->get_type() != beerocks::TYPE_CLIENT ||
+                    sta->stats_info->rx_rssi == beerocks::RSSI_INVALID) {
+                    return;
+                }
+                sBmlStatsData sta_stats;
+                sta_stats.type      = beerocks::TYPE_CLIENT;
+                sta_stats.mac       = sta->mac;
+                sta_stats.sta_stats = *sta->stats_info;
+                stats.push_back(std::move(sta_stats));
+            });
+    }
+}
 
-            get_next_node = fill_and_send(size, size_left, node_len, reserved_size, data_start);
-            if (get_next_node == 0) {
-                continue;
-            } else if (get_next_node < 0) {
-                return;
-            }
+void network_map::get_bml_nodes_statistics_records(const std::vector<sBmlStatsData> &stats,
+                                                   std::vector<std::vector<uint8_t>> &records)
+{
+    records.clear();
+    records.reserve(stats.size());
 
-            // sta's
-            auto sta_clients = database.get_node_children(hostap_mac);
-            for (auto sta = sta_clients.begin(); sta != sta_clients.end();) {
-                std::string sta_mac = *sta;
-                // LOG(DEBUG) << "sta mac = " << sta_mac;
-                n = database.get_node(sta_mac);
-                if (n == nullptr) {
-                    LOG(ERROR) << "n == nullptr";
-                    continue;
-                }
-                if (n != nullptr && n->state == beerocks::STATE_CONNECTED) {
-                    get_next_node =
-                        fill_and_send(size, size_left, node_len, reserved_size, data_start);
-                    if (get_next_node == 0) {
-                        continue;
-                    } else if (get_next_node < 0) {
-                        return;
-                    }
-                }
+    for (const auto &data : stats) {
+        std::vector<uint8_t> record(get_bml_node_statistics_len(data.type));
+        if (record.empty() || fill_bml_node_statistics(data, record.data(), record.size()) == 0) {
+            continue;
+        }
+        records.push_back(std::move(record));
+    }
+}
 
-                if (get_next_node) {
-                    ++sta;
-                }
-            }
+void network_map::send_bml_nodes_statistics_message(
+    ieee1905_1::CmduMessageTx &cmdu_tx, const std::vector<std::vector<uint8_t>> &records,
+    const send_message_t &send_message)
+{
+    size_t idx = 0;
+
+    do {
+        auto response =
+            message_com::create_vs_message<beerocks_message::cACTION_BML_STATS_UPDATE>(cmdu_tx);
+        if (response == nullptr) {
+            LOG(ERROR) << "Failed building ACTION_BML_STATS_UPDATE message!";
+            return;
         }
 
-        if (get_next_node) {
-            ++radio;
+        auto beerocks_header = message_com::get_vs_class_header(cmdu_tx);
+        if (!beerocks_header) {
+            LOG(ERROR) << "Failed getting beerocks_header!";
+            return;
         }
-    }
 
-    beerocks_header->last() = 1;
+        response->num_of_stats_bulks() = 0;
+        if (!append_bml_records(cmdu_tx, response, response->num_of_stats_bulks(), records,
+                                idx)) {
+            return;
+        }
 
-    //LOG(DEBUG) << "sending message, last=0";
-    // sending to all listeners
-    for (auto it = bml_listeners.begin(); it != bml_listeners.end(); ++it) {
-        message_com::send_cmdu(*it, cmdu_tx);
-    }
-    //LOG(DEBUG) << "sending message, last=1";
+        beerocks_header->last() = (idx == records.size()) ? 1 : 0;
+        send_message(cmdu_tx);
+    } while (idx < records.size());
 }
 
 void network_map::send_bml_event_to_listeners(ieee1905_1::CmduMessageTx &cmdu_tx,
@@ -689,12 +749,11 @@ void network_map::send_bml_cac_status_changed_notification_message_to_listeners(
     send_bml_event_to_listeners(cmdu_tx, bml_listeners);
 }
 
-std::ptrdiff_t network_map::get_bml_node_statistics_len(std::shared_ptr<node> n)
+std::ptrdiff_t network_map::get_bml_node_statistics_len(beerocks::eType type)
 {
-    auto n_type                   = n->get_type();
     std::ptrdiff_t stats_bulk_len = 0;
 
-    switch (n_type) {
+    switch (type) {
     case beerocks::TYPE_SLAVE: {
         stats_bulk_len =
             sizeof(BML_STATS) - sizeof(BML_STATS::S_TYPE) + sizeof(BML_STATS::S_TYPE::S_RADIO);
@@ -711,23 +770,16 @@ std::ptrdiff_t network_map::get_bml_node_statistics_len(std::shared_ptr<node> n)
     return stats_bulk_len;
 }
 
-std::ptrdiff_t network_map::fill_bml_node_statistics(db &database, std::shared_ptr<node> n,
+std::ptrdiff_t network_map::fill_bml_node_statistics(const sBmlStatsData &stats,
                                                      uint8_t *tx_buffer, std::ptrdiff_t buf_size)
 {
-    if (n == nullptr) {
-        LOG(ERROR) << "n == nullptr";
-        return 0;
-    }
-    auto n_type                   = n->get_type();
-    std::ptrdiff_t stats_bulk_len = 0;
-
-    stats_bulk_len = get_bml_node_statistics_len(n);
+    std::ptrdiff_t stats_bulk_len = get_bml_node_statistics_len(stats.type);
     if (stats_bulk_len > buf_size) {
         // LOG(DEBUG) << "buffer overflow!";
         return 0;
     }
 
-    switch (n_type) {
+    switch (stats.type) {
     case beerocks::TYPE_SLAVE: {
         //LOG(DEBUG) << "fill TYPE_SLAVE";
         //prepearing buffer and calc size
@@ -735,65 +787,50 @@ std::ptrdiff_t network_map::fill_bml_node_statistics(db &database, std::shared_p
 
         //fill radio stats
         //memset(radio_stats_bulk, 0, stats_bulk_len);
-        network_utils::mac_from_string(radio_stats_bulk->mac, n->mac);
+        network_utils::mac_from_string(radio_stats_bulk->mac, stats.mac);
         radio_stats_bulk->type = BML_STAT_TYPE_RADIO;
 
-        radio_stats_bulk->bytes_sent              = n->hostap->stats_info->tx_bytes;
-        radio_stats_bulk->bytes_received          = n->hostap->stats_info->rx_bytes;
-        radio_stats_bulk->packets_sent            = n->hostap->stats_info->tx_packets;
-        radio_stats_bulk->packets_received        = n->hostap->stats_info->rx_packets;
-        radio_stats_bulk->measurement_window_msec = n->hostap->stats_info->stats_delta_ms;
+        radio_stats_bulk->bytes_sent              = stats.radio_stats.tx_bytes;
+        radio_stats_bulk->bytes_received          = stats.radio_stats.rx_bytes;
+        radio_stats_bulk->packets_sent            = stats.radio_stats.tx_packets;
+        radio_stats_bulk->packets_received        = stats.radio_stats.rx_packets;
+        radio_stats_bulk->measurement_window_msec = stats.radio_stats.stats_delta_ms;
 
-        radio_stats_bulk->errors_sent       = n->hostap->stats_info->errors_sent;
-        radio_stats_bulk->errors_received   = n->hostap->stats_info->errors_received;
-        radio_stats_bulk->retrans_count     = n->hostap->stats_info->retrans_count;
-        radio_stats_bulk->uType.radio.noise = n->hostap->stats_info->noise;
+        radio_stats_bulk->errors_sent       = stats.radio_stats.errors_sent;
+        radio_stats_bulk->errors_received   = stats.radio_stats.errors_received;
+        radio_stats_bulk->retrans_count     = stats.radio_stats.retrans_count;
+        radio_stats_bulk->uType.radio.noise = stats.radio_stats.noise;
 
-        radio_stats_bulk->uType.radio.bss_load = n->hostap->stats_info->channel_load_percent;
+        radio_stats_bulk->uType.radio.bss_load = stats.radio_stats.channel_load_percent;
         break;
     }
-    case beerocks::TYPE_IRE_BACKHAUL: {
-        if (database.is_node_wireless(n->mac)) {
-            n_type = beerocks::TYPE_CLIENT;
-        } else {
-            break;
-        }
-    }
-        FALLTHROUGH;
     case beerocks::TYPE_CLIENT: {
         //LOG(DEBUG) << "fill TYPE_CLIENT";
 
-        // filter client which have not been measured yet
-        if (n->stats_info->rx_rssi == beerocks::RSSI_INVALID) {
-            //LOG(DEBUG) << "sta_mac=" << n->mac << ", signal_strength=INVALID!";
-            return buf_size;
-        }
-
         //prepearing buffer and calc size
         auto sta_stats_bulk = (BML_STATS *)tx_buffer;
 
         //fill sta stats
         //memset(sta_stats_bulk, 0, stats_bulk_len);
-        network_utils::mac_from_string(sta_stats_bulk->mac, n->mac);
+        network_utils::mac_from_string(sta_stats_bulk->mac, stats.mac);
         sta_stats_bulk->type = BML_STAT_TYPE_CLIENT;
 
-        sta_stats_bulk->bytes_sent              = n->stats_info->tx_bytes;
-        sta_stats_bulk->bytes_received          = n->stats_info->rx_bytes;
-        sta_stats_bulk->packets_sent            = n->stats_info->tx_packets;
-        sta_stats_bulk->packets_received        = n->stats_info->rx_packets;
-        sta_stats_bulk->measurement_window_msec = n->stats_info->stats_delta_ms;
-        sta_stats_bulk->retrans_count           = n->stats_info->retrans_count;
+        sta_stats_bulk->bytes_sent              = stats.sta_stats.tx_bytes;
+        sta_stats_bulk->bytes_received          = stats.sta_stats.rx_bytes;
+        sta_stats_bulk->packets_sent            = stats.sta_stats.tx_packets;
+        sta_stats_bulk->packets_received        = stats.sta_stats.rx_packets;
+        sta_stats_bulk->measurement_window_msec = stats.sta_stats.stats_delta_ms;
+        sta_stats_bulk->retrans_count           = stats.sta_stats.retrans_count;
 
         // These COMMON params are not available for station from FAPI
         sta_stats_bulk->errors_sent     = 0;
         sta_stats_bulk->errors_received = 0;
 
-        // LOG(DEBUG) << "sta_mac=" << n->mac << ", signal_strength=" << int(n->stats_info->rx_rssi);
-        sta_stats_bulk->uType.client.signal_strength = n->stats_info->rx_rssi;
+        sta_stats_bulk->uType.client.signal_strength = stats.sta_stats.rx_rssi;
         sta_stats_bulk->uType.client.last_data_downlink_rate =
-            n->stats_info->tx_phy_rate_100kb * 100000;
+            stats.sta_stats.tx_phy_rate_100kb * 100000;
         sta_stats_bulk->uType.client.last_data_uplink_rate =
-            n->stats_info->rx_phy_rate_100kb * 100000;
+            stats.sta_stats.rx_phy_rate_100kb * 100000;
 
         //These CLIENT SPECIFIC params are missing in DB:
         sta_stats_bulk->uType.client.retransmissions = 0;
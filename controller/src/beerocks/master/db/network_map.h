@@ -11,12 +11,71 @@
 
 #include "db.h"
 
+#include <functional>
+
 namespace son {
 class network_map {
 public:
-    static void send_bml_network_map_message(db &database, Socket *sd,
-                                             ieee1905_1::CmduMessageTx &cmdu_tx, uint16_t id);
+    // Copy of the db data serialized into the BML_NODE record of a node. The master thread takes
+    // the copy and the query worker builds the record from it, without accessing the db.
+    struct sBmlNodeData {
+        struct sRadio {
+            std::string mac;
+            std::string iface_name;
+            beerocks::eIfaceType iface_type;
+            std::string driver_version;
+            int channel;
+            bool cac_completed;
+            beerocks::eWiFiBandwidth bw;
+            bool channel_ext_above_secondary;
+            bool ap_active;
+            std::string radio_identifier;
+            std::unordered_map<int8_t, sVapElement> vaps_info;
+        };
+
+        beerocks::eType type;
+        beerocks::ePlatform platform;
+        beerocks::eNodeState state;
+        int channel;
+        beerocks::eWiFiBandwidth bw;
+        bool channel_ext_above_secondary;
+        std::string mac;
+        std::string parent_bridge;
+        std::string parent_bssid;
+        int8_t rx_rssi = 0;
+        std::string ipv4;
+        std::string name;
+        std::string backhaul_mac;
+        std::vector<sRadio> radios;
+    };
+
+    // Copy of the statistics of a radio or a client serialized into its BML_STATS record
+    struct sBmlStatsData {
+        beerocks::eType type;
+        std::string mac;
+        node::radio::ap_stats_params radio_stats;
+        node::sta_stats_params sta_stats;
+    };
 
+    // sends a message built in cmdu_tx
+    typedef std::function<void(ieee1905_1::CmduMessageTx &cmdu_tx)> send_message_t;
+
+    // copies the data of the network map nodes, in hierarchy order
+    static void get_bml_nw_map_data(db &database, std::vector<sBmlNodeData> &nodes);
+    // builds the BML_NODE records of the nodes, does not use the db so it can be called from
+    // the query worker
+    static void get_bml_nw_map_records(const std::vector<sBmlNodeData> &nodes,
+                                       std::vector<std::vector<uint8_t>> &records);
+    // sends the records as ACTION_BML_NW_MAP_RESPONSE messages, does not use the db so it can be
+    // called from the query worker
+    static void send_bml_network_map_message(ieee1905_1::CmduMessageTx &cmdu_tx, uint16_t id,
+                                             const std::vector<std::vector<uint8_t>> &records,
+                                             const send_message_t &send_message);
+
+    static bool get_bml_node_data(db &database, std::shared_ptr<node> n, sBmlNodeData &data,
+                                  bool force_client_disconnect = false);
+    static std::ptrdiff_t fill_bml_node_data(const sBmlNodeData &data, uint8_t *tx_buffer,
+                                             std::ptrdiff_t buffer_size);
     static std::ptrdiff_t fill_bml_node_data(db &database, std::shared_ptr<node> n,
                                              uint8_t *tx_buffer, std::ptrdiff_t &buffer_size,
                                              bool force_client_disconnect = false);
@@ -24,13 +83,37 @@ public:
                                              std::ptrdiff_t &buffer_size,
                                              bool force_client_disconnect);
 
-    static void send_bml_nodes_statistics_message_to_listeners(db &database,
-                                                               ieee1905_1::CmduMessageTx &cmdu_tx,
-                                                               std::vector<Socket *> bml_listeners,
-                                                               std::set<std::string> valid_hostaps);
-    static std::ptrdiff_t fill_bml_node_statistics(db &database, std::shared_ptr<node> n,
+    // fills the BML_NODE record of the node (empty if it does not exist),
+    // returns true if the node is part of the network map (connected GW/IRE/client)
+    static bool get_bml_nw_map_node_record(db &database, const std::string &mac,
+                                           std::vector<uint8_t> &record,
+                                           bool force_client_disconnect = false);
+    static void
+    get_bml_nw_map_node_records(db &database,
+                                std::unordered_map<std::string, std::vector<uint8_t>> &records);
+    // every delta message takes the next sequence number, all the messages of a snapshot
+    // carry the current one and the last of them is sent with last=1
+    static void send_bml_nw_map_update_message(ieee1905_1::CmduMessageTx &cmdu_tx,
+                                               std::vector<Socket *> bml_listeners,
+                                               const std::vector<std::vector<uint8_t>> &records,
+                                               uint32_t &sequence_num, bool snapshot);
+
+    // copies the statistics of the connected radios of valid_hostaps and of their measured
+    // connected clients
+    static void get_bml_nodes_statistics_data(db &database,
+                                              const std::set<std::string> &valid_hostaps,
+                                              std::vector<sBmlStatsData> &stats);
+    // builds the BML_STATS records, does not use the db so it can be called from the query worker
+    static void get_bml_nodes_statistics_records(const std::vector<sBmlStatsData> &stats,
+                                                 std::vector<std::vector<uint8_t>> &records);
+    // sends the records as ACTION_BML_STATS_UPDATE messages, does not use the db so it can be
+    // called from the query worker
+    static void send_bml_nodes_statistics_message(ieee1905_1::CmduMessageTx &cmdu_tx,
+                                                  const std::vector<std::vector<uint8_t>> &records,
+                                                  const send_message_t &send_message);
+    static std::ptrdiff_t fill_bml_node_statistics(const sBmlStatsData &stats,
                                                    uint8_t *tx_buffer, std::ptrdiff_t buf_size);
-    static std::ptrdiff_t get_bml_node_statistics_len(std::shared_ptr<node> n);
+    static std::ptrdiff_t get_bml_node_statistics_len(beerocks::eType type);
 
     static void send_bml_event_to_listeners(ieee1905_1::CmduMessageTx &cmdu_tx,
                                             std::vector<Socket *> &bml_listeners);
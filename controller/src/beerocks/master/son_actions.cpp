@@ -109,20 +109,29 @@ void son_actions::handle_completed_connection(db &database, ieee1905_1::CmduMess
 
 bool son_actions::add_node_to_default_location(db &database, std::string client_mac)
 {
+    std::string gw_mac;
     std::string gw_lan_switch;
 
-    auto gw_container = database.get_nodes_from_hierarchy(0, beerocks::TYPE_GW);
-    if (gw_container.empty()) {
+    // there is a single GW with a single LAN switch, take the first one found
+    database.for_each_node_in_hierarchy(0, beerocks::TYPE_GW, [&](const std::string &mac) {
+        if (gw_mac.empty()) {
+            gw_mac = mac;
+        }
+    });
+    if (gw_mac.empty()) {
         LOG(WARNING)
             << "add_node_to_default_location - can't get GW node, adding to default location...";
     } else {
-        auto gw_mac          = *gw_container.begin();
-        auto gw_lan_switches = database.get_node_children(gw_mac, beerocks::TYPE_ETH_SWITCH);
-        if (gw_lan_switches.empty()) {
+        database.for_each_node_child(
+            gw_mac, beerocks::TYPE_ETH_SWITCH, beerocks::STATE_ANY, [&](const std::string &mac) {
+                if (gw_lan_switch.empty()) {
+                    gw_lan_switch = mac;
+                }
+            });
+        if (gw_lan_switch.empty()) {
             LOG(ERROR) << "add_node_to_default_location - GW has no LAN SWITCH node!";
             return false;
         }
-        gw_lan_switch = *gw_lan_switches.begin();
     }
 
     //LOG(DEBUG) << "adding node " << client_mac << " to db, after getting ARP_MONITOR_NOTIFICATION from source " << int(notification->params.source);
@@ -143,14 +152,17 @@ void son_actions::unblock_sta(db &database, ieee1905_1::CmduMessageTx &cmdu_tx,
 {
     LOG(DEBUG) << "unblocking " << sta_mac << " from network";
 
-    auto hostaps = database.get_active_hostaps();
-    for (auto &hostap : hostaps) {
+    bool failed = false;
+    database.for_each_active_hostap([&](const std::string &hostap) {
         /*
          * unblock client from all hostaps to prevent it from getting locked out
          */
+        if (failed) {
+            return;
+        }
         if (database.get_hostap_exclude_from_steering_flag(hostap)) {
             LOG(DEBUG) << "hostap " << hostap << " is excluded from steering, skipping";
-            continue;
+            return;
         }
         Socket *sd = database.get_node_socket(hostap);
         auto request =
@@ -158,13 +170,14 @@ void son_actions::unblock_sta(db &database, ieee1905_1::CmduMessageTx &cmdu_tx,
                 cmdu_tx);
         if (request == nullptr) {
             LOG(ERROR) << "Failed building ACTION_CONTROL_CLIENT_ALLOW_REQUEST message!";
-            break;
+            failed = true;
+            return;
         }
         request->mac() = network_utils::mac_from_string(sta_mac);
 
         son_actions::send_cmdu_to_agent(sd, cmdu_tx, hostap);
         LOG(DEBUG) << "sending allow request for " << sta_mac << " to " << hostap;
-    }
+    });
 }
 
 int son_actions::steer_sta(db &database, ieee1905_1::CmduMessageTx &cmdu_tx, task_pool &tasks,
@@ -401,18 +414,20 @@ void son_actions::handle_dead_node(std::string mac, std::string hostap_mac, db &
             LOG(DEBUG) << "BML, sending client disconnect CONNECTION_CHANGE for mac "
                        << new_event.mac;
         } else if (mac_type == beerocks::TYPE_IRE_BACKHAUL) {
-            auto backhauls_bridge = database.get_node_children(mac, beerocks::TYPE_IRE);
-            if (backhauls_bridge.empty()) {
-                LOG(ERROR) << "backhaul has no bridge node under it!";
-            } else {
-                for (auto it = backhauls_bridge.begin(); it != backhauls_bridge.end(); it++) {
+            // the BML task only reads the db while handling the event
+            bool has_bridge = false;
+            database.for_each_node_child(
+                mac, beerocks::TYPE_IRE, beerocks::STATE_ANY, [&](const std::string &bridge) {
+                    has_bridge = true;
                     bml_task::connection_change_event new_event;
-                    new_event.mac = *it;
+                    new_event.mac = bridge;
                     LOG(DEBUG) << "BML, sending IRE disconnect CONNECTION_CHANGE for mac "
                                << new_event.mac;
                     tasks.push_event(database.get_bml_task_id(), bml_task::CONNECTION_CHANGE,
                                      &new_event);
-                }
+                });
+            if (!has_bridge) {
+                LOG(ERROR) << "backhaul has no bridge node under it!";
             }
         }
     }
@@ -981,7 +981,8 @@ void son_management::handle_bml_message(
 
     case beerocks_message::ACTION_BML_NW_MAP_REQUEST: {
         LOG(TRACE) << "ACTION_BML_NW_MAP_REQUEST";
-        network_map::send_bml_network_map_message(database, sd, cmdu_tx, beerocks_header->id());
+        // sent by the master query worker, see master_thread::dispatch_bml_queries()
+        database.add_bml_nw_map_request(sd, beerocks_header->id());
     } break;
 
     case beerocks_message::ACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST: {
@@ -25,6 +25,7 @@
 #include "tasks/ire_network_optimization_task.h"
 #include "tasks/network_health_check_task.h"
 
+#include <beerocks/bcl/beerocks_message_buffer_pool.h>
 #include <beerocks/bcl/beerocks_version.h>
 #include <beerocks/bcl/son/son_wireless_utils.h>
 #include <easylogging++.h>
@@ -87,9 +88,20 @@ bool master_thread::init()
         LOG(DEBUG) << "Health check is DISABLED!";
     }
 
+    if (!query_worker.start("query_worker")) {
+        LOG(ERROR) << "Failed starting the query worker";
+        return false;
+    }
+
     return socket_thread::init();
 }
 
+void master_thread::on_thread_stop()
+{
+    LOG(DEBUG) << "Stopping the query worker...";
+    query_worker.stop(true);
+}
+
 bool master_thread::work()
 {
     if (!socket_thread::work()) {
@@ -100,7 +112,12 @@ bool master_thread::work()
     return true;
 }
 
-void master_thread::before_select() { database.unlock(); }
+void master_thread::before_select()
+{
+    // the db is consistent at the end of the iteration, copy out what the queries need
+    dispatch_bml_queries();
+    database.unlock();
+}
 
 void master_thread::after_select(bool timeout) { database.lock(); }
 
@@ -132,6 +149,8 @@ bool master_thread::socket_disconnected(Socket *sd)
             LOG(DEBUG) << "socket with no mac disconnect sd=" << intptr_t(sd);
             database.remove_cli_socket(sd);
             database.remove_bml_socket(sd);
+            // the socket is deleted once we return
+            cancel_query_jobs(sd);
 #ifdef BEEROCKS_RDKB
             if (database.settings_rdkb_extensions()) {
                 //TODO - use rdkb_wlan_hal_db instead of task event
@@ -149,6 +168,96 @@ bool master_thread::socket_disconnected(Socket *sd)
     return true;
 }
 
+void master_thread::dispatch_bml_queries()
+{
+    for (auto it = query_jobs.begin(); it != query_jobs.end();) {
+        if ((*it)->done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            it = query_jobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // sends cmdu_tx to the sockets of the job which were not removed meanwhile
+    auto send_to_job_sockets = [](std::shared_ptr<sQueryJob> job,
+                                  ieee1905_1::CmduMessageTx &cmdu_tx) {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        for (auto sd : job->sockets) {
+            if (sd) {
+                message_com::send_cmdu(sd, cmdu_tx);
+            }
+        }
+    };
+
+    auto nw_map_requests = database.pop_bml_nw_map_requests();
+    if (!nw_map_requests.empty()) {
+        // all the requests of an iteration are served from the same copy of the map
+        auto nodes = std::make_shared<std::vector<network_map::sBmlNodeData>>();
+        network_map::get_bml_nw_map_data(database, *nodes);
+
+        for (const auto &request : nw_map_requests) {
+            auto job = std::make_shared<sQueryJob>();
+            job->sockets.push_back(request.sd);
+            job->done = query_worker.enqueue<void>(
+                [nodes, job, send_to_job_sockets](uint16_t id) {
+                    std::vector<std::vector<uint8_t>> records;
+                    network_map::get_bml_nw_map_records(*nodes, records);
+
+                    // the whole map usually fits in a single large message
+                    large_cmdu_tx nw_map_cmdu_tx;
+                    network_map::send_bml_network_map_message(
+                        nw_map_cmdu_tx.get(), id, records,
+                        [&](ieee1905_1::CmduMessageTx &cmdu_tx) {
+                            send_to_job_sockets(job, cmdu_tx);
+                        });
+                },
+                request.id);
+            query_jobs.push_back(job);
+        }
+    }
+
+    for (const auto &valid_hostaps : database.pop_bml_stats_updates()) {
+        int idx = 0;
+        std::vector<Socket *> stats_updates_listeners;
+        Socket *sd;
+        while ((sd = database.get_bml_socket_at(idx)) != nullptr) {
+            if (database.get_bml_stats_update_enable(sd)) {
+                stats_updates_listeners.push_back(sd);
+            }
+            idx++;
+        }
+        if (stats_updates_listeners.empty()) {
+            continue;
+        }
+
+        auto stats = std::make_shared<std::vector<network_map::sBmlStatsData>>();
+        network_map::get_bml_nodes_statistics_data(database, valid_hostaps, *stats);
+
+        auto job     = std::make_shared<sQueryJob>();
+        job->sockets = std::move(stats_updates_listeners);
+        job->done    = query_worker.enqueue<void>([stats, job, send_to_job_sockets]() {
+            std::vector<std::vector<uint8_t>> records;
+            network_map::get_bml_nodes_statistics_records(*stats, records);
+
+            large_cmdu_tx stats_cmdu_tx;
+            network_map::send_bml_nodes_statistics_message(
+                stats_cmdu_tx.get(), records,
+                [&](ieee1905_1::CmduMessageTx &cmdu_tx) { send_to_job_sockets(job, cmdu_tx); });
+        });
+        query_jobs.push_back(job);
+    }
+}
+
+void master_thread::cancel_query_jobs(Socket *sd)
+{
+    // the jobs keep running for their other sockets, at most a single send to sd in progress
+    // is waited for
+    for (const auto &job : query_jobs) {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        std::replace(job->sockets.begin(), job->sockets.end(), sd, static_cast<Socket *>(nullptr));
+    }
+}
+
 void master_thread::disconnected_slave_cleanup()
 {
     while (!database.disconnected_slave_mac_queue_empty()) {
@@ -227,7 +336,7 @@ bool master_thread::handle_cmdu_1905_autoconfiguration_search(Socket *sd,
     std::string al_mac;
 
     LOG(DEBUG) << "Received AP_AUTOCONFIGURATION_SEARCH_MESSAGE";
-    auto tlvAlMacAddressType = cmdu_rx.addClass<ieee1905_1::tlvAlMacAddressType>();
+    auto tlvAlMacAddressType = cmdu_rx.getTlv<ieee1905_1::tlvAlMacAddressType>();
     if (tlvAlMacAddressType) {
         al_mac =
             network_utils::mac_to_string((const unsigned char *)tlvAlMacAddressType->mac().oct);
@@ -237,7 +346,7 @@ bool master_thread::handle_cmdu_1905_autoconfiguration_search(Socket *sd,
         return false;
     }
 
-    auto tlvSearchedRole = cmdu_rx.addClass<ieee1905_1::tlvSearchedRole>();
+    auto tlvSearchedRole = cmdu_rx.getTlv<ieee1905_1::tlvSearchedRole>();
     if (tlvSearchedRole) {
         LOG(DEBUG) << "searched_role=" << int(tlvSearchedRole->value());
         if (tlvSearchedRole->value() != ieee1905_1::tlvSearchedRole::REGISTRAR) {
@@ -249,9 +358,9 @@ bool master_thread::handle_cmdu_1905_autoconfiguration_search(Socket *sd,
         return false;
     }
 
-    auto tlvAutoconfigFreqBand = cmdu_rx.addClass<ieee1905_1::tlvAutoconfigFreqBand>();
+    auto tlvAutoconfigFreqBand = cmdu_rx.getTlv<ieee1905_1::tlvAutoconfigFreqBand>();
     if (!tlvAutoconfigFreqBand) {
-        LOG(ERROR) << "addClass ieee1905_1::tlvAutoconfigFreqBand failed";
+        LOG(ERROR) << "getTlv ieee1905_1::tlvAutoconfigFreqBand failed";
     }
 
     auto &auto_config_freq_band = tlvAutoconfigFreqBand->value();
@@ -262,7 +371,7 @@ bool master_thread::handle_cmdu_1905_autoconfiguration_search(Socket *sd,
         return false;
     }
 
-    auto tlvSupportedServiceIn = cmdu_rx.addClass<wfa_map::tlvSupportedService>();
+    auto tlvSupportedServiceIn = cmdu_rx.getTlv<wfa_map::tlvSupportedService>();
     if (tlvSupportedServiceIn) {
         for (int i = 0; i < tlvSupportedServiceIn->supported_service_list_length(); i++) {
             auto supportedServiceTuple = tlvSupportedServiceIn->supported_service_list(i);
@@ -284,7 +393,7 @@ bool master_thread::handle_cmdu_1905_autoconfiguration_search(Socket *sd,
         return false;
     }
 
-    auto tlvSearchedService = cmdu_rx.addClass<wfa_map::tlvSearchedService>();
+    auto tlvSearchedService = cmdu_rx.getTlv<wfa_map::tlvSearchedService>();
     if (tlvSearchedService) {
         for (int i = 0; i < tlvSearchedService->searched_service_list_length(); i++) {
             auto searchedServiceTuple = tlvSearchedService->searched_service_list(i);
@@ -1013,12 +1122,13 @@ bool master_thread::handle_intel_slave_join(Socket *sd, ieee1905_1::CmduMessageR
 
     if (backhaul_manager) {
         // clear backhaul manager flag for all slaves except for this backhaul_manager slave
-        auto ire_hostaps = database.get_node_children(bridge_mac, beerocks::TYPE_SLAVE);
-        for (auto tmp_slave_mac : ire_hostaps) {
-            if (tmp_slave_mac != radio_mac) {
-                database.set_hostap_backhaul_manager(tmp_slave_mac, false);
-            }
-        }
+        database.for_each_node_child(
+            bridge_mac, beerocks::TYPE_SLAVE, beerocks::STATE_ANY,
+            [&](const std::string &tmp_slave_mac) {
+                if (tmp_slave_mac != radio_mac) {
+                    database.set_hostap_backhaul_manager(tmp_slave_mac, false);
+                }
+            });
     }
     database.set_hostap_repeater_mode_flag(radio_mac, notification->enable_repeater_mode());
     database.set_hostap_backhaul_manager(radio_mac, backhaul_manager);
@@ -1169,6 +1279,44 @@ bool master_thread::handle_intel_slave_join(Socket *sd, ieee1905_1::CmduMessageR
     return true;
 }
 
+void master_thread::handle_client_rx_rssi_measurement_notification(
+    const std::string &hostap_mac, const beerocks_message::sNodeRssiMeasurement &params)
+{
+    std::string client_mac    = network_utils::mac_to_string(params.result.mac);
+    std::string client_parent = database.get_node_parent(client_mac);
+    std::string ap_mac        = database.get_hostap_vap_mac(hostap_mac, params.vap_id);
+    bool is_parent = (client_parent == database.get_hostap_vap_mac(ap_mac, params.vap_id));
+
+    int rx_rssi = int(params.rx_rssi);
+
+    LOG_CLI(DEBUG, "measurement change notification: "
+                       << client_mac << " (sta) <-> (ap) " << ap_mac << " rx_rssi=" << rx_rssi
+                       << " phy_rate_100kb (RX|TX)=" << int(params.rx_phy_rate_100kb) << " | "
+                       << int(params.tx_phy_rate_100kb));
+
+    if ((database.get_node_type(client_mac) == beerocks::TYPE_CLIENT) &&
+        (database.get_node_state(client_mac) == beerocks::STATE_CONNECTED) &&
+        (!database.get_node_handoff_flag(client_mac)) && is_parent) {
+
+        database.set_node_cross_rx_rssi(client_mac, ap_mac, params.rx_rssi, 1);
+        database.set_node_cross_tx_phy_rate_100kb(client_mac, params.tx_phy_rate_100kb);
+        database.set_node_cross_rx_phy_rate_100kb(client_mac, params.rx_phy_rate_100kb);
+
+        /*
+         * when a notification arrives, it means a large change in rx_rssi occurred (above the defined thershold)
+         * therefore, we need to create an optimal path task to relocate the node if needed
+         */
+        int prev_task_id = database.get_roaming_task_id(client_mac);
+        if (tasks.is_task_running(prev_task_id)) {
+            LOG(DEBUG) << "roaming task already running for " << client_mac;
+        } else {
+            auto new_task = std::make_shared<optimal_path_task>(database, cmdu_tx, tasks,
+                                                                client_mac, 0, "");
+            tasks.add_task(new_task);
+        }
+    }
+}
+
 bool master_thread::handle_cmdu_control_message(
     Socket *sd, std::shared_ptr<beerocks_message::cACTION_HEADER> beerocks_header,
     ieee1905_1::CmduMessageRx &cmdu_rx)
@@ -1593,42 +1741,27 @@ bool master_thread::handle_cmdu_control_message(
             LOG(ERROR) << "addClass ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION failed";
             return false;
         }
-        std::string client_mac    = network_utils::mac_to_string(notification->params().result.mac);
-        std::string client_parent = database.get_node_parent(client_mac);
-        std::string ap_mac = database.get_hostap_vap_mac(hostap_mac, notification->params().vap_id);
-        bool is_parent =
-            (client_parent == database.get_hostap_vap_mac(ap_mac, notification->params().vap_id));
-
-        int rx_rssi = int(notification->params().rx_rssi);
-
-        LOG_CLI(DEBUG,
-                "measurement change notification: "
-                    << client_mac << " (sta) <-> (ap) " << ap_mac << " rx_rssi=" << rx_rssi
-                    << " phy_rate_100kb (RX|TX)=" << int(notification->params().rx_phy_rate_100kb)
-                    << " | " << int(notification->params().tx_phy_rate_100kb));
-
-        if ((database.get_node_type(client_mac) == beerocks::TYPE_CLIENT) &&
-            (database.get_node_state(client_mac) == beerocks::STATE_CONNECTED) &&
-            (!database.get_node_handoff_flag(client_mac)) && is_parent) {
-
-            database.set_node_cross_rx_rssi(client_mac, ap_mac, notification->params().rx_rssi, 1);
-            database.set_node_cross_tx_phy_rate_100kb(client_mac,
-                                                      notification->params().tx_phy_rate_100kb);
-            database.set_node_cross_rx_phy_rate_100kb(client_mac,
-                                                      notification->params().rx_phy_rate_100kb);
+        handle_client_rx_rssi_measurement_notification(hostap_mac, notification->params());
+        break;
+    }
+    case beerocks_message::ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION: {
+        auto notification = cmdu_rx.addClass<
+            beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>();
+        if (notification == nullptr) {
+            LOG(ERROR)
+                << "addClass ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION failed";
+            return false;
+        }
 
-            /*
-                * when a notification arrives, it means a large change in rx_rssi occurred (above the defined thershold)
-                * therefore, we need to create an optimal path task to relocate the node if needed
-                */
-            int prev_task_id = database.get_roaming_task_id(client_mac);
-            if (tasks.is_task_running(prev_task_id)) {
-                LOG(DEBUG) << "roaming task already running for " << client_mac;
-            } else {
-                auto new_task = std::make_shared<optimal_path_task>(database, cmdu_tx, tasks,
-                                                                    client_mac, 0, "");
-                tasks.add_task(new_task);
+        // the database is locked for the whole handling, so all the measurements of the
+        // poll cycle are applied together
+        for (auto i = 0; i < notification->params_size(); i++) {
+            auto params_tuple = notification->params(i);
+            if (!std::get<0>(params_tuple)) {
+                LOG(ERROR) << "Couldn't access measurement in location " << i;
+                continue;
             }
+            handle_client_rx_rssi_measurement_notification(hostap_mac, std::get<1>(params_tuple));
         }
         break;
     }
@@ -2007,17 +2140,19 @@ bool master_thread::handle_cmdu_control_message(
                 continue;
             }
             auto &sta_stats = std::get<1>(sta_stats_tuple);
-            auto client_mac = network_utils::mac_to_string(sta_stats.mac);
 
-            if (!database.has_node(client_mac)) {
-                LOG(ERROR) << "sta " << client_mac << " is not in DB!";
+            // binary mac lookups, the string form is only needed for logging
+            if (!database.has_node(sta_stats.mac)) {
+                LOG(ERROR) << "sta " << network_utils::mac_to_string(sta_stats.mac)
+                           << " is not in DB!";
                 continue;
-            } else if (database.get_node_state(client_mac) != beerocks::STATE_CONNECTED) {
-                LOG(DEBUG) << "sta " << client_mac << " is not connected to hostap " << hostap_mac
+            } else if (database.get_node_state(sta_stats.mac) != beerocks::STATE_CONNECTED) {
+                LOG(DEBUG) << "sta " << network_utils::mac_to_string(sta_stats.mac)
+                           << " is not connected to hostap " << hostap_mac
                            << ", update is invalid!";
                 continue;
             }
-            database.set_node_stats_info(client_mac, &sta_stats);
+            database.set_node_stats_info(sta_stats.mac, &sta_stats);
         }
 
         database.set_hostap_stats_info(hostap_mac, &response->ap_stats());
@@ -13,6 +13,7 @@
 #include "tasks/optimal_path_task.h"
 #include "tasks/task_pool.h"
 
+#include <beerocks/bcl/beerocks_async_work_queue.h>
 #include <beerocks/bcl/beerocks_defines.h>
 #include <beerocks/bcl/beerocks_logging.h>
 #include <beerocks/bcl/beerocks_message_structs.h>
@@ -21,6 +22,9 @@
 
 #include <cstddef>
 #include <ctime>
+#include <future>
+#include <list>
+#include <mutex>
 #include <stdint.h>
 
 namespace ieee1905_1 {
@@ -43,15 +47,20 @@ protected:
     virtual void before_select() override;
     virtual void after_select(bool timeout) override;
     virtual std::string print_cmdu_types(const beerocks::message::sUdsHeader *cmdu_header) override;
+    virtual void on_thread_stop() override;
 
 private:
     void disconnected_slave_cleanup();
+    void dispatch_bml_queries();
+    void cancel_query_jobs(Socket *sd);
     bool handle_cmdu_1905_1_message(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx);
     bool
     handle_cmdu_control_message(Socket *sd,
                                 std::shared_ptr<beerocks_message::cACTION_HEADER> beerocks_header,
                                 ieee1905_1::CmduMessageRx &cmdu_rx);
     void handle_cmdu_control_ieee1905_1_message(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx);
+    void handle_client_rx_rssi_measurement_notification(
+        const std::string &hostap_mac, const beerocks_message::sNodeRssiMeasurement &params);
     bool handle_intel_slave_join(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx,
                                  ieee1905_1::CmduMessageTx &cmdu_tx, const std::string &radio_mac);
 
@@ -64,6 +73,19 @@ private:
 
     db &database;
     task_pool tasks;
+
+    // builds and sends the BML query responses off the master thread, from data copied out of
+    // the db
+    beerocks::async_work_queue query_worker;
+    // a job of the query worker and the sockets it writes to, a socket is set to nullptr under
+    // the mutex once it is removed so the job skips it
+    struct sQueryJob {
+        std::mutex mutex;
+        std::vector<Socket *> sockets;
+        std::future<void> done;
+    };
+    // jobs of the query worker which may still be running
+    std::list<std::shared_ptr<sQueryJob>> query_jobs;
 };
 
 } // namespace son
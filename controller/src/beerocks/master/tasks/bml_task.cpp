@@ -11,12 +11,12 @@
 #include "../db/network_map.h"
 #include "bml_defs.h"
 
+#include <beerocks/bcl/beerocks_message_buffer_pool.h>
 #include <beerocks/bcl/network/network_utils.h>
 #include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_bml.h>
-#include <tlvf/ieee_1905_1/tlvEndOfMessage.h>
 
 #include <climits>
 
@@ -44,6 +44,7 @@ void bml_task::work()
         break;
     }
     case LISTENING: {
+        send_bml_nw_map_changes(database.pop_bml_nw_map_changed_nodes(), false);
         wait_for(1000);
         break;
     }
@@ -99,8 +100,8 @@ void bml_task::handle_event(int event_type, void *obj)
                 idx++;
             }
             if (!stats_updates_listeners.empty()) {
-                network_map::send_bml_nodes_statistics_message_to_listeners(
-                    database, cmdu_tx, stats_updates_listeners, event_obj->valid_hostaps);
+                // sent by the master query worker, see master_thread::dispatch_bml_queries()
+                database.add_bml_stats_update(event_obj->valid_hostaps);
             }
         }
         break;
@@ -197,10 +198,17 @@ void bml_task::handle_event(int event_type, void *obj)
         if (obj) {
             auto event_obj = (listener_general_register_unregister_event *)obj;
             TASK_LOG(DEBUG) << "REGISTER_TO_NW_MAP_UPDATES event was received";
+
+            // bring the current listeners up to date before taking the snapshot
+            if (database.is_bml_nw_map_listener_exist()) {
+                send_bml_nw_map_changes(database.pop_bml_nw_map_changed_nodes(), false);
+            }
+
             database.add_bml_socket(event_obj->sd);
             if (!database.set_bml_nw_map_update_enable(event_obj->sd, true)) {
                 TASK_LOG(DEBUG) << "fail in changing nw_update registration";
             }
+            send_bml_nw_map_snapshot(event_obj->sd);
             state = LISTENING;
         }
         break;
@@ -213,6 +221,9 @@ void bml_task::handle_event(int event_type, void *obj)
             if (!database.set_bml_nw_map_update_enable(event_obj->sd, false)) {
                 TASK_LOG(DEBUG) << "fail in changing nw_map_update unregistration";
             }
+            if (!database.is_bml_nw_map_listener_exist()) {
+                nw_map_sent_nodes.clear();
+            }
             if (!database.is_bml_listener_exist()) {
                 state = IDLE;
             }
@@ -279,6 +290,11 @@ void bml_task::handle_event(int event_type, void *obj)
 }
 
 void bml_task::update_bml_nw_map(std::string mac, bool force_client_disconnect)
+{
+    send_bml_nw_map_changes({mac}, true, force_client_disconnect);
+}
+
+std::vector<Socket *> bml_task::get_bml_nw_map_listeners()
 {
     int idx = 0;
     std::vector<Socket *> nw_map_updates_listeners;
@@ -289,40 +305,76 @@ void bml_task::update_bml_nw_map(std::string mac, bool force_client_disconnect)
         }
         idx++;
     }
+    return nw_map_updates_listeners;
+}
 
-    if (!nw_map_updates_listeners.empty()) {
-
-        auto response =
-            message_com::create_vs_message<beerocks_message::cACTION_BML_NW_MAP_UPDATE>(cmdu_tx);
-
-        if (response == nullptr) {
-            LOG(ERROR) << "Failed building ACTION_BML_NW_MAP_UPDATE message!";
-            return;
-        }
+void bml_task::send_bml_nw_map_changes(const std::set<std::string> &macs, bool explicit_change,
+                                       bool force_client_disconnect)
+{
+    if (macs.empty()) {
+        return;
+    }
 
-        // Set number of transmitted nodes
-        response->node_num() = 1;
+    auto nw_map_updates_listeners = get_bml_nw_map_listeners();
+    if (nw_map_updates_listeners.empty()) {
+        return;
+    }
 
-        size_t node_size;
-        auto node_type = database.get_node_type(mac);
-        if (node_type == beerocks::TYPE_GW || node_type == beerocks::TYPE_IRE) {
-            node_size = sizeof(BML_NODE);
+    std::vector<std::vector<uint8_t>> records;
+    for (const auto &mac : macs) {
+        std::vector<uint8_t> record;
+        bool in_map =
+            network_map::get_bml_nw_map_node_record(database, mac, record, force_client_disconnect);
+        auto sent = nw_map_sent_nodes.find(mac);
+
+        if (in_map) {
+            if (sent != nw_map_sent_nodes.end() && sent->second == record) {
+                // nothing the listeners don't already have
+                continue;
+            }
+            nw_map_sent_nodes[mac] = record;
         } else {
-            node_size = sizeof(BML_NODE) - sizeof(BML_NODE::N_DATA::N_GW_IRE);
-        }
-
-        std::ptrdiff_t size_left = cmdu_tx.getMessageBuffLength() - cmdu_tx.getMessageLength() -
-                                   ieee1905_1::tlvEndOfMessage::get_initial_size();
-
-        if (!response->alloc_buffer(node_size)) {
-            LOG(ERROR) << "Failed buffer allocation to size=" << int(node_size);
-            return;
+            // left the map (disconnected or removed) or an explicitly reported state change
+            if (sent == nw_map_sent_nodes.end()) {
+                if (!explicit_change || record.empty()) {
+                    continue;
+                }
+            } else {
+                if (record.empty()) {
+                    record = sent->second;
+                    reinterpret_cast<BML_NODE *>(record.data())->state =
+                        BML_NODE_STATE_DISCONNECTED;
+                }
+                nw_map_sent_nodes.erase(sent);
+            }
         }
+        records.push_back(std::move(record));
+    }
 
-        uint8_t *p = (uint8_t *)response->buffer(0);
+    if (records.empty()) {
+        return;
+    }
 
-        network_map::fill_bml_node_data(database, mac, p, size_left, force_client_disconnect);
+    large_cmdu_tx update_cmdu_tx;
+    network_map::send_bml_nw_map_update_message(update_cmdu_tx.get(), nw_map_updates_listeners,
+                                                records, nw_map_update_seq, false);
+}
 
-        network_map::send_bml_event_to_listeners(cmdu_tx, nw_map_updates_listeners);
+void bml_task::send_bml_nw_map_snapshot(Socket *sd)
+{
+    // the snapshot is always built from the db, the records the listeners were updated with
+    // are refreshed from it so the next deltas are computed against what the new listener has
+    network_map::get_bml_nw_map_node_records(database, nw_map_sent_nodes);
+
+    std::vector<std::vector<uint8_t>> records;
+    records.reserve(nw_map_sent_nodes.size());
+    for (const auto &sent : nw_map_sent_nodes) {
+        records.push_back(sent.second);
     }
+
+    TASK_LOG(DEBUG) << "sending network map snapshot, nodes=" << records.size()
+                    << " sequence_num=" << nw_map_update_seq;
+    large_cmdu_tx snapshot_cmdu_tx;
+    network_map::send_bml_nw_map_update_message(snapshot_cmdu_tx.get(), {sd}, records,
+                                                nw_map_update_seq, true);
 }
@@ -106,6 +106,15 @@ private:
     task_pool &tasks;
 
     void update_bml_nw_map(std::string mac, bool force_client_disconnect = false);
+    std::vector<Socket *> get_bml_nw_map_listeners();
+    void send_bml_nw_map_changes(const std::set<std::string> &macs, bool explicit_change,
+                                 bool force_client_disconnect = false);
+    void send_bml_nw_map_snapshot(Socket *sd);
+
+    // sequence number of the last network map delta sent to the listeners
+    uint32_t nw_map_update_seq = 0;
+    // last node records the network map listeners were updated with
+    std::unordered_map<std::string, std::vector<uint8_t>> nw_map_sent_nodes;
 };
 
 } // namespace son
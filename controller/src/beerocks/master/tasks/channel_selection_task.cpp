@@ -996,15 +996,16 @@ void channel_selection_task::work()
         }
 
         if (!database.settings_client_band_steering()) {
-            auto clients = database.get_node_children(hostap_mac, beerocks::TYPE_CLIENT);
-            auto it =
-                std::find_if(clients.begin(), clients.end(), [&](const std::string &client_mac) {
+            bool clients_connected = false;
+            database.for_each_node_child(
+                hostap_mac, beerocks::TYPE_CLIENT, beerocks::STATE_ANY,
+                [&](const std::string &client_mac) {
                     auto client_state = (uint8_t)database.get_node_state(client_mac);
-                    return client_state >= eNodeState::STATE_CONNECTING &&
-                           client_state <= STATE_CONNECTED_IP_UNKNOWN;
+                    clients_connected |= client_state >= eNodeState::STATE_CONNECTING &&
+                                         client_state <= STATE_CONNECTED_IP_UNKNOWN;
                 });
 
-            if (it != clients.end()) {
+            if (clients_connected) {
                 LOG(DEBUG) << "band steering feature is not enabled and client are connected to "
                               "hostap_mac="
                            << hostap_mac << ", can't run DFS reentry";
@@ -1230,17 +1231,10 @@ bool channel_selection_task::reentry_steered_client_check()
                                          now - dfs_reentry_pending_steered_clients->timestamp)
                                          .count();
     if (dfs_reentry_clients_delta < REENTRY_STEERED_CLIENTS_WAIT) {
-        auto set_reentry_clients =
-            database.get_node_children(hostap_mac, TYPE_CLIENT, STATE_CONNECTED);
-
-        if (set_reentry_clients.empty()) {
+        if (database.count_node_children(hostap_mac, TYPE_CLIENT, STATE_CONNECTED) == 0) {
             TASK_LOG(DEBUG) << "no client connected to reentry hostap ";
             return true;
         }
-        for_each(begin(set_reentry_clients), end(set_reentry_clients),
-                 [&](std::string set_reentry_client) {
-                     //LOG(DEBUG) << "set_reentry_client connected = " << set_reentry_client;
-                 });
         //inject the event back to the end of the queue
         //TASK_LOG(DEBUG) << "hostap_mac - " << hostap_mac << " sta's are still connected injecting sta sample event ";
         auto new_event = CHANNEL_SELECTION_ALLOCATE_EVENT(sDfsReEntrySampleSteeredClients_event);
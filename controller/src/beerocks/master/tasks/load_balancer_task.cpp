@@ -102,8 +102,8 @@ void load_balancer_task::work()
                 most_loaded_hostap = hostap;
                 max_load           = hostap_channel_load;
             } else if (hostap_channel_load == max_load) {
-                if (database.get_node_children(hostap).size() >
-                    database.get_node_children(most_loaded_hostap).size()) {
+                if (database.count_node_children(hostap) >
+                    database.count_node_children(most_loaded_hostap)) {
                     /*
                          * TODO might need different sta count criteria for 2.4ghz and 5ghz hostaps
                          */
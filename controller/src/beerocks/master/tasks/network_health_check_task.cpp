@@ -72,8 +72,7 @@ void network_health_check_task::work()
     }
 
     case CLIENT_HEALTH_CHECK: {
-        auto clients = database.get_nodes(beerocks::TYPE_CLIENT);
-        for (auto &client : clients) {
+        database.for_each_node(beerocks::TYPE_CLIENT, [&](const std::string &client) {
             auto last_seen = database.get_node_last_seen(client);
             if (!database.is_node_wireless(client) &&
                 (database.get_node_state(client) == beerocks::STATE_CONNECTED)) {
@@ -86,7 +85,7 @@ void network_health_check_task::work()
                     //TASK_LOG(DEBUG) << "insert client = " << client << " last_seen_delta = " << int(last_seen_delta);
                 }
             }
-        }
+        });
         state = SEND_QUERY;
         break;
     }
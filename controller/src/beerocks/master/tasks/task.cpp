@@ -11,6 +11,8 @@
 #include <beerocks/bcl/beerocks_utils.h>
 #include <easylogging++.h>
 
+#include <algorithm>
+
 using namespace beerocks;
 using namespace son;
 
@@ -160,6 +162,40 @@ void task::execute()
 
 bool task::is_done() { return done; }
 
+std::chrono::steady_clock::time_point task::next_wakeup_time()
+{
+    if (done || !waiting) {
+        return std::chrono::steady_clock::time_point::min();
+    }
+
+    // mirrors the wait conditions checked by execute()
+    auto wakeup = std::chrono::steady_clock::time_point::max();
+    if ((waiting_for_events && pending_events.empty()) ||
+        (waiting_for_responses && pending_macs.empty()) ||
+        (!responses_timeout_set && !waiting_for_events && !waiting_for_responses &&
+         !waiting_for_pending_task)) {
+        wakeup = std::chrono::steady_clock::time_point::min();
+    } else {
+        if (waiting_for_pending_task) {
+            wakeup = std::min(wakeup, pending_task_timeout);
+        }
+        if (events_timeout_set && waiting_for_events) {
+            wakeup = std::min(wakeup, events_timeout);
+        }
+        if (responses_timeout_set) {
+            wakeup = std::min(wakeup, responses_timeout);
+        }
+    }
+    wakeup = std::max(wakeup, next_action_time);
+
+    if (task_timeout_set) {
+        wakeup = std::min(wakeup, task_timeout);
+    }
+    return wakeup;
+}
+
+int task::get_pending_task_id() { return waiting_for_pending_task ? pending_task_id : -1; }
+
 void task::kill()
 {
     TASK_LOG(DEBUG) << "killed!";
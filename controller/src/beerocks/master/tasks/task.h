@@ -9,8 +9,9 @@
 #ifndef _TASK_H_
 #define _TASK_H_
 
-#define TASK_LOG(a) (LOG(a) << "task " << task_name << " id " << id << ": ")
+#define TASK_LOG(a) LOG_IF_ENABLED(a) << "task " << task_name << " id " << id << ": "
 
+#include <beerocks/bcl/beerocks_logging.h>
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_control.h>
 
@@ -35,6 +36,15 @@ public:
     bool is_done();
     void kill();
 
+    /*
+     * Earliest point in time at which execute() can make progress without an external
+     * signal (event, response, pending task end or kill).
+     * Returns time_point::min() if the task is runnable now and time_point::max() if it
+     * is blocked until signalled.
+     */
+    std::chrono::steady_clock::time_point next_wakeup_time();
+    int get_pending_task_id();
+
     std::string task_name;
     const std::string assigned_node;
     const int id;
@@ -10,14 +10,25 @@
 
 #include <easylogging++.h>
 
+#include <algorithm>
+
 using namespace beerocks;
 using namespace son;
 
+constexpr size_t task_pool::TIMER_WHEEL_SLOTS;
+
+task_pool::task_pool() : timer_wheel_time(std::chrono::steady_clock::now()) {}
+
 bool task_pool::add_task(std::shared_ptr<task> new_task)
 {
     LOG(TRACE) << "inserting new task, id=" << int(new_task->id)
                << " task_name=" << new_task->task_name;
-    return (scheduled_tasks.insert(std::make_pair(new_task->id, new_task))).second;
+    if (!(scheduled_tasks.insert(std::make_pair(new_task->id, new_task))).second) {
+        return false;
+    }
+    index_pending_task(new_task->id, new_task);
+    ready_tasks.insert(new_task->id);
+    return true;
 }
 
 bool task_pool::is_task_running(int id)
@@ -36,6 +47,7 @@ void task_pool::kill_task(int id)
     if (it != scheduled_tasks.end() && it->second != nullptr) {
         LOG(DEBUG) << "killing task " << it->second->task_name << ", id " << it->first;
         it->second->kill();
+        ready_tasks.insert(id);
     }
 }
 
@@ -45,6 +57,8 @@ void task_pool::push_event(int task_id, int event_type, void *obj)
     if (it != scheduled_tasks.end()) {
         if (it->second != nullptr) {
             it->second->event_received(event_type, obj);
+            index_pending_task(task_id, it->second);
+            ready_tasks.insert(task_id);
         } else {
             LOG(ERROR) << "invalid task " << task_id;
         }
@@ -55,10 +69,16 @@ void task_pool::push_event(int task_id, int event_type, void *obj)
 
 void task_pool::pending_task_ended(int task_id)
 {
-    //TODO find a more efficient way for this
-    for (auto t : scheduled_tasks) {
-        t.second->pending_task_ended(task_id);
+    auto range = pending_task_waiters.equal_range(task_id);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto t = scheduled_tasks.find(it->second);
+        if (t == scheduled_tasks.end()) {
+            continue;
+        }
+        t->second->pending_task_ended(task_id);
+        ready_tasks.insert(t->first);
     }
+    pending_task_waiters.erase(task_id);
 }
 
 void task_pool::response_received(int id, std::string mac,
@@ -68,19 +88,113 @@ void task_pool::response_received(int id, std::string mac,
     std::unordered_map<int, std::shared_ptr<task>>::const_iterator got = scheduled_tasks.find(id);
     if (got != scheduled_tasks.end()) {
         got->second->response_received(mac, action_op, cmdu_rx);
+        index_pending_task(id, got->second);
+        ready_tasks.insert(id);
+    }
+}
+
+void task_pool::index_pending_task(int id, std::shared_ptr<task> t)
+{
+    int pending_task_id = t->get_pending_task_id();
+    if (pending_task_id < 0) {
+        return;
+    }
+    auto range      = pending_task_waiters.equal_range(pending_task_id);
+    bool registered =
+        std::any_of(range.first, range.second,
+                    [id](const std::pair<const int, int> &waiter) { return waiter.second == id; });
+    if (!registered) {
+        pending_task_waiters.insert({pending_task_id, id});
+    }
+}
+
+void task_pool::schedule_task(int id, std::shared_ptr<task> t)
+{
+    index_pending_task(id, t);
+
+    auto now    = std::chrono::steady_clock::now();
+    auto wakeup = t->next_wakeup_time();
+    if (wakeup <= now) {
+        armed_timers.erase(id);
+        ready_tasks.insert(id);
+        return;
+    } else if (wakeup == std::chrono::steady_clock::time_point::max()) {
+        // blocked until signalled
+        armed_timers.erase(id);
+        return;
+    }
+
+    auto armed = armed_timers.find(id);
+    if (armed != armed_timers.end() && armed->second == wakeup) {
+        return;
+    }
+    armed_timers[id] = wakeup;
+
+    // round up so the slot is never processed before the timer expires
+    auto tick  = std::chrono::milliseconds(TIMER_WHEEL_TICK_MSEC);
+    auto ticks = (wakeup - timer_wheel_time + tick - std::chrono::nanoseconds(1)) / tick;
+    auto slot  = (timer_wheel_pos + size_t(ticks)) % TIMER_WHEEL_SLOTS;
+    timer_wheel[slot].push_back({id, wakeup});
+}
+
+void task_pool::advance_timer_wheel(std::chrono::steady_clock::time_point now)
+{
+    auto tick          = std::chrono::milliseconds(TIMER_WHEEL_TICK_MSEC);
+    auto ticks_elapsed = (now - timer_wheel_time) / tick;
+    if (ticks_elapsed <= 0) {
+        return;
+    }
+    timer_wheel_time += ticks_elapsed * tick;
+
+    // after a long stall a single revolution covers every slot
+    auto steps = std::min(size_t(ticks_elapsed), TIMER_WHEEL_SLOTS);
+    for (size_t i = 0; i < steps; ++i) {
+        timer_wheel_pos = (timer_wheel_pos + 1) % TIMER_WHEEL_SLOTS;
+        auto &slot      = timer_wheel[timer_wheel_pos];
+        for (auto it = slot.begin(); it != slot.end();) {
+            auto armed = armed_timers.find(it->task_id);
+            if (armed == armed_timers.end() || armed->second != it->expiry) {
+                // stale - task was rescheduled or erased
+                it = slot.erase(it);
+            } else if (it->expiry <= now) {
+                ready_tasks.insert(it->task_id);
+                armed_timers.erase(armed);
+                it = slot.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (size_t(ticks_elapsed) > TIMER_WHEEL_SLOTS) {
+        timer_wheel_pos = (timer_wheel_pos + size_t(ticks_elapsed) - TIMER_WHEEL_SLOTS) %
+                          TIMER_WHEEL_SLOTS;
     }
 }
 
 void task_pool::run_tasks()
 {
-    for (auto it = scheduled_tasks.begin(); it != scheduled_tasks.end();) {
-        it->second->execute();
-        if (it->second->is_done()) {
-            pending_task_ended(it->first);
-            LOG(DEBUG) << "erasing task " << it->second->task_name << ", id " << it->first;
-            it = scheduled_tasks.erase(it);
+    advance_timer_wheel(std::chrono::steady_clock::now());
+
+    // tasks which become ready while running (new tasks, events pushed from work()) run on
+    // the next call, same as a task inserted while iterating the pool
+    std::set<int> run_now;
+    run_now.swap(ready_tasks);
+
+    for (int id : run_now) {
+        auto it = scheduled_tasks.find(id);
+        if (it == scheduled_tasks.end()) {
+            continue;
+        }
+        auto t = it->second;
+        t->execute();
+        if (t->is_done()) {
+            LOG(DEBUG) << "erasing task " << t->task_name << ", id " << id;
+            scheduled_tasks.erase(id);
+            armed_timers.erase(id);
+            ready_tasks.erase(id);
+            pending_task_ended(id);
         } else {
-            ++it;
+            schedule_task(id, t);
         }
     }
 }
@@ -13,12 +13,16 @@
 
 #include <beerocks/tlvf/beerocks_message_action.h>
 
+#include <array>
+#include <set>
+#include <vector>
+
 namespace son {
 
 class task_pool {
 
 public:
-    task_pool() {}
+    task_pool();
     ~task_pool() {}
 
     bool add_task(std::shared_ptr<task> new_task);
@@ -31,7 +35,33 @@ public:
     void run_tasks();
 
 private:
+    // Hashed timer wheel - every slot holds the timers expiring on one tick, timers that are
+    // more than a full revolution away stay in their slot until their expiry is reached
+    static constexpr int TIMER_WHEEL_TICK_MSEC = 10;
+    static constexpr size_t TIMER_WHEEL_SLOTS  = 512;
+
+    struct sTimer {
+        int task_id;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    void index_pending_task(int id, std::shared_ptr<task> t);
+    void schedule_task(int id, std::shared_ptr<task> t);
+    void advance_timer_wheel(std::chrono::steady_clock::time_point now);
+
     std::unordered_map<int, std::shared_ptr<task>> scheduled_tasks;
+
+    // tasks to execute on the next run_tasks(), ordered by id (creation order)
+    std::set<int> ready_tasks;
+
+    std::array<std::vector<sTimer>, TIMER_WHEEL_SLOTS> timer_wheel;
+    size_t timer_wheel_pos = 0;
+    std::chrono::steady_clock::time_point timer_wheel_time;
+    // task id -> currently armed timer expiry, stale wheel entries are dropped lazily
+    std::unordered_map<int, std::chrono::steady_clock::time_point> armed_timers;
+
+    // awaited task id -> ids of the tasks waiting for it to end
+    std::unordered_multimap<int, int> pending_task_waiters;
 };
 
 } // namespace son
@@ -7,9 +7,10 @@ add_definitions(-DELPP_FORCE_USE_STD_THREAD)
 add_definitions(-DELPP_NO_DEFAULT_LOG_FILE)
 add_library(${ELPP_LIB_NAME} UNKNOWN IMPORTED)
 
-# Include directory
+# Include directory and the log levels disabled at build time
 set_target_properties(${ELPP_LIB_NAME} PROPERTIES
     INTERFACE_INCLUDE_DIRECTORIES "${ELPP_INCLUDE_DIRS}"
+    INTERFACE_COMPILE_DEFINITIONS "${ELPP_LOG_LEVEL_DEFINITIONS}"
 )
 
 # Library
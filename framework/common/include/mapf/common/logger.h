@@ -9,14 +9,24 @@
 #ifndef __MAPF_COMMON_LOGGER_H__
 #define __MAPF_COMMON_LOGGER_H__
 
+#include <atomic>
 #include <easylogging++.h>
 #include <iomanip> //for resetiosflags
 #include <mapf/common/config.h>
 
-#define MAPF_ERR(msg) LOG(ERROR) << msg << resetiosflags((std::ios_base::fmtflags)0xFFFF)
-#define MAPF_WARN(msg) LOG(WARNING) << msg << resetiosflags((std::ios_base::fmtflags)0xFFFF)
-#define MAPF_INFO(msg) LOG(INFO) << msg << resetiosflags((std::ios_base::fmtflags)0xFFFF)
-#define MAPF_DBG(msg) LOG(DEBUG) << msg << resetiosflags((std::ios_base::fmtflags)0xFFFF)
+// The message is not built at all if the level is disabled, at build time (LOG_MIN_LEVEL) or by
+// the logger configuration
+#define MAPF_LOG(LEVEL, compiled, level, msg)                                                      \
+    do {                                                                                           \
+        if (compiled && mapf::Logger::LevelEnabled(el::Level::level)) {                            \
+            LOG(LEVEL) << msg << resetiosflags((std::ios_base::fmtflags)0xFFFF);                   \
+        }                                                                                          \
+    } while (0)
+
+#define MAPF_ERR(msg) MAPF_LOG(ERROR, ELPP_ERROR_LOG, Error, msg)
+#define MAPF_WARN(msg) MAPF_LOG(WARNING, ELPP_WARNING_LOG, Warning, msg)
+#define MAPF_INFO(msg) MAPF_LOG(INFO, ELPP_INFO_LOG, Info, msg)
+#define MAPF_DBG(msg) MAPF_LOG(DEBUG, ELPP_DEBUG_LOG, Debug, msg)
 
 #define MAPF_ERR_IF(cond, msg)                                                                     \
     LOG_IF(cond, ERROR) << msg << resetiosflags((std::ios_base::fmtflags)0xFFFF)
@@ -56,6 +66,7 @@ public:
         size_t log_flush_threshold() { return log_flush_threshold_; }
         int SetValuesFromJson(std::string file_path, std::string logger_name);
         std::string ToEasyLoggingString();
+        el::base::type::EnumType EnabledLevels();
 
     private:
         std::string level_ = "DEBUG", file_path_ = "logs.log";
@@ -77,8 +88,14 @@ public:
     void LoggerConfig(const char *logger_name);
     void LoggerConfig(Logger::Config &cfg);
     const char *logger_name() { return logger_name_.c_str(); } //for all API users
+    static bool LevelEnabled(el::Level level)
+    {
+        return levels_.load(std::memory_order_relaxed) & el::LevelHelper::castToInt(level);
+    }
 
 private:
+    // levels enabled by the last applied configuration, all until then
+    static std::atomic<el::base::type::EnumType> levels_;
     std::string logger_name_         = "";
     const char *kSyslogMessageFormat = "[mapf] [%proc] %fbase[%line]: %msg";
     Logger() {}
@@ -27,27 +27,72 @@ public:
 
     class Frame {
     public:
-        Frame(size_t len, const void *init_data = nullptr)
-            : data_(std::make_shared<std::vector<uint8_t>>(len))
+        Frame(size_t len, const void *init_data = nullptr) : Frame()
         {
+            set_size(len);
             if (init_data)
                 set_data(init_data, len);
         }
 
-        Frame() : Frame(0) {}
+        /**
+         * Frame over memory owned by the caller (e.g. a pool buffer or a received socket
+         * message), the data is not copied. owner is released with the last copy of the frame,
+         * pass nullptr if the memory outlives all the copies. The data is copied to a buffer
+         * owned by the frame only if the frame grows beyond len.
+         */
+        Frame(void *data, size_t len, std::shared_ptr<void> owner)
+            : data_(owner, static_cast<uint8_t *>(data)), len_(len), capacity_(len)
+        {
+        }
+
+        Frame() {}
+        Frame(const Frame &) = default;
+        Frame(Frame &&other)
+            : data_(std::move(other.data_)), len_(other.len_), capacity_(other.capacity_)
+        {
+            other.len_      = 0;
+            other.capacity_ = 0;
+        }
+        Frame &operator=(const Frame &) = default;
+        Frame &operator=(Frame &&other)
+        {
+            data_           = std::move(other.data_);
+            len_            = other.len_;
+            capacity_       = other.capacity_;
+            other.len_      = 0;
+            other.capacity_ = 0;
+            return *this;
+        }
         virtual ~Frame() {}
 
-        size_t len() const { return data_->size(); }
+        size_t len() const { return len_; }
 
-        uint8_t *data() const { return data_->data(); }
+        uint8_t *data() const { return data_.get(); }
         std::string str() const { return std::string(reinterpret_cast<char *>(data()), len()); }
 
-        void set_size(size_t size) { data_->resize(size); }
+        // The data is shared by all the copies of a frame but the size is not, resizing only
+        // affects this copy. Like std::vector::resize, bytes added by growing the frame are zeroed.
+        // Growing a frame whose data is shared (with another copy or with the caller-owned
+        // buffer) moves it to a new buffer, so the bytes past the end of this copy are never
+        // zeroed under the other copies.
+        void set_size(size_t size)
+        {
+            if (size > capacity_ || (size > len_ && data_.use_count() != 1)) {
+                std::shared_ptr<uint8_t> data(new uint8_t[size](),
+                                              std::default_delete<uint8_t[]>());
+                std::copy_n(data_.get(), len_, data.get());
+                data_     = std::move(data);
+                capacity_ = size;
+            } else if (size > len_) {
+                std::fill_n(data_.get() + len_, size - len_, 0);
+            }
+            len_ = size;
+        }
 
         void set_data(const void *data, size_t len)
         {
             set_size(len);
-            std::copy_n((uint8_t *)data, len, data_->data());
+            std::copy_n((uint8_t *)data, len, data_.get());
         }
 
         virtual std::ostream &print(std::ostream &os) const
@@ -56,7 +101,9 @@ public:
         }
 
     private:
-        std::shared_ptr<std::vector<uint8_t>> data_ = nullptr;
+        std::shared_ptr<uint8_t> data_ = nullptr;
+        size_t len_                    = 0;
+        size_t capacity_               = 0;
     }; // class Frame
 
     struct Header {
@@ -70,36 +117,77 @@ public:
 
     Message(const std::string &topic, std::initializer_list<Frame> frames) : Message(topic)
     {
-        for (auto frame : frames)
+        for (const auto &frame : frames)
             Add(frame);
     }
 
+    Message(const Message &) = default;
+    Message(Message &&other)
+        : topic_(std::move(other.topic_)), frames_(std::move(other.frames_)), len_(other.len_)
+    {
+        other.frames_.clear();
+        other.len_ = 0;
+    }
+    Message &operator=(const Message &) = default;
+    Message &operator=(Message &&other)
+    {
+        topic_  = std::move(other.topic_);
+        frames_ = std::move(other.frames_);
+        len_    = other.len_;
+        other.frames_.clear();
+        other.len_ = 0;
+        return *this;
+    }
+
     virtual ~Message(){};
 
-    void Add(Frame &frame) { frames_.push_back(frame); }
+    void Add(const Frame &frame)
+    {
+        frames_.push_back(frame);
+        len_ += frame.len();
+    }
+
+    void Add(Frame &&frame)
+    {
+        len_ += frame.len();
+        frames_.push_back(std::move(frame));
+    }
 
     void Clear()
     {
         frames_.clear();
         topic_.clear();
+        len_ = 0;
+    }
+
+    // Resize the last frame, frames must not be resized directly so the message length is kept
+    // up to date
+    void ResizeFrame(size_t size)
+    {
+        mapf_assert(!frames_.empty());
+        len_ = len_ - frames_.back().len() + size;
+        frames_.back().set_size(size);
     }
 
     // Get the first frame
-    Frame frame() const { return frames_.empty() ? Frame() : frames_.back(); }
+    const Frame &frame() const
+    {
+        static const Frame empty;
+        return frames_.empty() ? empty : frames_.back();
+    }
 
     // Accessors & Mutators
     const Header header() const
     {
         Header hdr;
-        for (auto f : frames_)
-            hdr.len += f.len();
+        hdr.len = len_;
         return hdr;
     }
 
-    uint32_t version() const { return header().version; }
-    uint32_t len() const { return header().len; }
+    uint32_t version() const { return kMessageHeaderVersion; }
+    uint32_t len() const { return len_; }
 
-    std::vector<Frame> &frames() const { return frames_; }
+    const std::vector<Frame> &frames() const { return frames_; }
     virtual const std::string topic() const { return topic_; }
     virtual void set_topic(const std::string &topic) { topic_ = topic; }
 
@@ -116,7 +204,9 @@ public:
 
 private:
     std::string topic_;
-    mutable std::vector<Frame> frames_;
+    std::vector<Frame> frames_;
+    // total length of the frames, kept up to date instead of summing the frames on every access
+    uint32_t len_ = 0;
 };
 
 inline std::ostream &operator<<(std::ostream &os, const Message::Frame &f) { return f.print(os); }
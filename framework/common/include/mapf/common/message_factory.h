@@ -27,6 +27,13 @@ public:
     std::unique_ptr<Message> Create(const std::string &topic,
                                     std::initializer_list<Message::Frame> frames) const;
 
+    /**
+     * Same as Create(), but msg is reused (instead of allocating a new message) if it holds a
+     * message of the type created for topic.
+     */
+    void Create(std::unique_ptr<Message> &msg, const std::string &topic,
+                std::initializer_list<Message::Frame> frames) const;
+
     void DumpMakers()
     {
         std::cout << "Factory registered Message Makers:" << std::endl;
@@ -35,10 +42,19 @@ public:
     }
 
 private:
-    std::map<std::string, MessageMakerBase *>::const_iterator Find(const std::string &topic) const;
+    // return the maker with the shortest topic prefix matching topic (or nullptr)
+    MessageMakerBase *Find(const std::string &topic) const;
 
     // map of all Message Makers where the key is the topic prefix
     std::map<std::string, MessageMakerBase *> makers_;
+
+    // the topic prefixes of all Message Makers in a trie, so the lookup is linear in the length
+    // of the topic instead of in the number of makers
+    struct TrieNode {
+        MessageMakerBase *maker = nullptr; // the maker of the prefix which ends at this node
+        std::map<char, std::unique_ptr<TrieNode>> children;
+    };
+    TrieNode trie_;
 };
 
 } /* namespace mapf */
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <memory>
 #include <string.h>
+#include <typeinfo>
 
 namespace mapf {
 
@@ -24,6 +25,10 @@ public:
     virtual std::unique_ptr<Message> Create(const std::string &topic,
                                             std::initializer_list<Message::Frame> frames) const = 0;
     virtual const std::string &topic_prefix() const                                             = 0;
+
+    // re-create msg in place if it is of the type created by this maker, return false otherwise
+    virtual bool Reuse(Message &msg, const std::string &topic,
+                       std::initializer_list<Message::Frame> frames) const = 0;
     virtual ~MessageMakerBase() {}
 };
 
@@ -45,6 +50,17 @@ public:
         return std::unique_ptr<T>{new T(topic, frames)};
     }
 
+    virtual bool Reuse(Message &msg, const std::string &topic,
+                       std::initializer_list<Message::Frame> frames) const
+    {
+        if (typeid(msg) != typeid(T)) {
+            return false;
+        }
+        // the message object (and the capacity of its topic and frames) is kept
+        static_cast<T &>(msg) = T(topic, frames);
+        return true;
+    }
+
     virtual const std::string &topic_prefix() const { return topic_prefix_; }
 
 private:
@@ -51,10 +51,24 @@ public:
     bool Send(const Message &msg, int flags = 0);
     size_t Send(void *buf, size_t len, int flags); //TODO - change to private
 
+    /**
+     * Zero-copy mode - frames larger than kZeroCopyMinFrameLength are handed to the messaging
+     * library by reference (the frame buffer is kept alive until the library is done with it)
+     * instead of being copied. When enabled, the frames of a sent message must not be modified
+     * after Send() returns. Ignored by messaging libraries which do not support it.
+     */
+    void SetZeroCopy(bool enable) { zero_copy_ = enable; }
+    bool ZeroCopy() const { return zero_copy_; }
+
+    // Below this size copying is cheaper than the bookkeeping needed to share the frame
+    static const size_t kZeroCopyMinFrameLength = 256;
+
 private:
     PubSocket();
+    bool SendFrame(const Message::Frame &frame, int flags);
     static std::string padTopic(const std::string &topic);
     static const char topic_pad_char = '\0';
+    bool zero_copy_                  = false;
 };
 
 class SubSocket : public Socket {
@@ -97,6 +111,12 @@ public:
     /** Receive APIs - prefer unique_ptr versions (uses factory) */
     bool Receive(Message &msg, int flags = 0);
     std::unique_ptr<Message> Receive(int flags = 0);
+    /**
+     * Same as Receive(flags), but the received message is stored in msg, reusing the message
+     * object it holds if it is of the type created for the received topic. Receiving in a loop
+     * into the same msg does not allocate a message per received message.
+     */
+    bool Receive(std::unique_ptr<Message> &msg, int flags = 0);
     ssize_t Receive(void *buf, size_t len, int flags = 0); //TODO - change to private
     bool Receive(Message::Frame &frame, int flags = 0);    //TODO - change to private
 
@@ -104,13 +124,14 @@ private:
     SubSocket();
     std::vector<std::string>::iterator FindSubscription(const std::string &topic);
     bool More() const;
-    std::unique_ptr<std::string> ReceiveTopic(int flags);
-    std::unique_ptr<Message::Header> ReceiveHeader(int flags);
+    bool ReceiveTopic(std::string &topic, int flags);
+    bool ReceiveHeader(Message::Header &hdr, int flags);
     Message::Frame ReceiveFrames(size_t total_len, int flags);
     void EraseSubscription(const std::string &topic);
     void AddSubscription(const std::string &topic);
 
     std::vector<std::string> topics_;
+    std::string rx_topic_; // the topic of the last received message (reused between receives)
 };
 
 inline std::ostream &operator<<(std::ostream &os, const Socket &socket) { return socket.Print(os); }
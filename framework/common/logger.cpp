@@ -20,6 +20,8 @@ SHARE_EASYLOGGINGPP(
 #define DEFAULT_LOGGER_NAME "default"
 
 namespace mapf {
+std::atomic<el::base::type::EnumType> Logger::levels_(~el::base::type::EnumType(0));
+
 static const char *get_name(const el::LogMessage *message) //for easylogging use
 {
     return mapf::Logger::Instance().logger_name();
@@ -129,6 +131,7 @@ void Logger::LoggerConfig(Logger::Config &cfg)
     el::Configurations conf;
     conf.parseFromText(cfg.ToEasyLoggingString().c_str());
     el::Loggers::reconfigureLogger(DEFAULT_LOGGER_NAME, conf);
+    levels_ = cfg.EnabledLevels();
 }
 
 int Logger::Config::SetValuesFromJson(std::string file_path, std::string logger_name)
@@ -222,4 +225,22 @@ std::string Logger::Config::ToEasyLoggingString()
 
     return settings;
 }
+
+el::base::type::EnumType Logger::Config::EnabledLevels()
+{
+    // the levels enabled by ToEasyLoggingString()
+    auto error   = el::LevelHelper::castToInt(el::Level::Error);
+    auto warning = el::LevelHelper::castToInt(el::Level::Warning) | error;
+    auto info    = el::LevelHelper::castToInt(el::Level::Info) | warning;
+    auto debug   = el::LevelHelper::castToInt(el::Level::Debug) | info;
+
+    if (level_.compare("INFO") == 0) {
+        return info;
+    } else if (level_.compare("WARNING") == 0) {
+        return warning;
+    } else if (level_.compare("ERROR") == 0) {
+        return error;
+    }
+    return debug;
+}
 } // namespace mapf
\ No newline at end of file
@@ -6,7 +6,6 @@
  * See LICENSE file for more details.
  */
 
-#include <algorithm>
 #include <iostream>
 #include <map>
 #include <mapf/common/err.h>
@@ -14,6 +13,7 @@
 #include <mapf/common/message_factory.h>
 #include <mapf/common/message_maker.h>
 #include <string.h>
+#include <typeinfo>
 
 namespace mapf {
 
@@ -25,16 +25,25 @@ MessageFactory &MessageFactory::Instance()
 
 void MessageFactory::RegisterMaker(const std::string &topic_prefix, MessageMakerBase *maker)
 {
-    auto it = Find(topic_prefix);
-    mapf_assert(it == makers_.end()); // we don't allow multiple makers for the same topic prefix
+    auto found = Find(topic_prefix);
+    mapf_assert(!found); // we don't allow multiple makers for the same topic prefix
     makers_[topic_prefix] = maker;
+
+    TrieNode *node = &trie_;
+    for (char c : topic_prefix) {
+        auto &child = node->children[c];
+        if (!child) {
+            child.reset(new TrieNode);
+        }
+        node = child.get();
+    }
+    node->maker = maker;
 }
 
 std::unique_ptr<Message> MessageFactory::Create(const std::string &topic) const
 {
-    auto it = Find(topic);
-    if (it != makers_.end()) {
-        MessageMakerBase *maker = it->second;
+    MessageMakerBase *maker = Find(topic);
+    if (maker) {
         return maker->Create(topic);
     }
     return std::unique_ptr<Message>{new Message(topic)};
@@ -43,21 +52,45 @@ std::unique_ptr<Message> MessageFactory::Create(const std::string &topic) const
 std::unique_ptr<Message> MessageFactory::Create(const std::string &topic,
                                                 std::initializer_list<Message::Frame> frames) const
 {
-    auto it = Find(topic);
-    if (it != makers_.end()) {
-        MessageMakerBase *maker = it->second;
+    MessageMakerBase *maker = Find(topic);
+    if (maker) {
         return maker->Create(topic, frames);
     }
     return std::unique_ptr<Message>{new Message(topic, frames)};
 }
 
-std::map<std::string, MessageMakerBase *>::const_iterator
-MessageFactory::Find(const std::string &topic) const
+void MessageFactory::Create(std::unique_ptr<Message> &msg, const std::string &topic,
+                            std::initializer_list<Message::Frame> frames) const
+{
+    MessageMakerBase *maker = Find(topic);
+    if (maker) {
+        if (!msg || !maker->Reuse(*msg, topic, frames)) {
+            msg = maker->Create(topic, frames);
+        }
+    } else if (msg && typeid(*msg) == typeid(Message)) {
+        *msg = Message(topic, frames);
+    } else {
+        msg.reset(new Message(topic, frames));
+    }
+}
+
+MessageMakerBase *MessageFactory::Find(const std::string &topic) const
 {
-    return std::find_if(makers_.begin(), makers_.end(),
-                        [&topic](const std::pair<std::string, MessageMakerBase *> &m) {
-                            return (topic.find(m.first) == 0);
-                        });
+    const TrieNode *node = &trie_;
+    if (node->maker) {
+        return node->maker; // empty topic prefix
+    }
+    for (char c : topic) {
+        auto it = node->children.find(c);
+        if (it == node->children.end()) {
+            return nullptr;
+        }
+        node = it->second.get();
+        if (node->maker) {
+            return node->maker;
+        }
+    }
+    return nullptr;
 }
 
 } /* namespace mapf */
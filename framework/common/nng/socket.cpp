@@ -96,7 +96,7 @@ bool PubSocket::Send(const Message &msg, int flags)
     std::string paddedTopic = padTopic(msg.topic());
 
     uint totalLen = paddedTopic.length();
-    for (auto frame : msg.frames()) {
+    for (const auto &frame : msg.frames()) {
         totalLen += frame.len();
     }
 
@@ -104,7 +104,7 @@ bool PubSocket::Send(const Message &msg, int flags)
     int copied = 0;
     memcpy(buf, (void *)paddedTopic.data(), paddedTopic.length());
     copied = paddedTopic.length();
-    for (auto frame : msg.frames()) {
+    for (const auto &frame : msg.frames()) {
         memcpy(buf + copied, frame.data(), frame.len());
         copied += frame.len();
     }
@@ -119,6 +119,9 @@ bool PubSocket::Send(const std::unique_ptr<Message> &msg, int flags)
     return Send(*msg, flags);
 }
 
+// nng sends the whole message as a single buffer, frames are never sent on their own
+bool PubSocket::SendFrame(const Message::Frame &frame, int flags) { return false; }
+
 std::string PubSocket::padTopic(const std::string &topic)
 {
     std::ostringstream s;
@@ -231,16 +234,25 @@ bool SubSocket::Receive(Message &msg, int flags)
 }
 
 std::unique_ptr<Message> SubSocket::Receive(int flags)
+{
+    std::unique_ptr<Message> msg;
+    if (!Receive(msg, flags))
+        return nullptr;
+
+    return msg;
+}
+
+bool SubSocket::Receive(std::unique_ptr<Message> &msg, int flags)
 {
     void *buf = nullptr;
     size_t size;
     int rc = nng_recv(sock->sd_, &buf, &size, NNG_FLAG_ALLOC); //buffer is allocated by nanomsg
     if (rc != 0) {
         MAPF_ERR("Can't allocate buffer for message");
-        return nullptr;
+        return false;
     }
-    std::string topic = std::string((char *)buf, 0, Message::kMaxTopicSize);
-    int nbytes        = size - Message::kMaxTopicSize;
+    rx_topic_.assign((char *)buf, strnlen((char *)buf, Message::kMaxTopicSize));
+    int nbytes = size - Message::kMaxTopicSize;
     Message::Frame frame(
         nbytes,
         (uint8_t *)buf +
@@ -248,12 +260,13 @@ std::unique_ptr<Message> SubSocket::Receive(int flags)
                 kMaxTopicSize); //The constructor copies the data into the frame internal buffer
     nng_free(buf, size);
     DBG("message received");
-    return MessageFactory::Instance().Create(topic, {frame});
+    MessageFactory::Instance().Create(msg, rx_topic_, {frame});
+    return true;
 }
 
 bool SubSocket::More() const { return false; }
-std::unique_ptr<std::string> SubSocket::ReceiveTopic(int flags) { return nullptr; }
-std::unique_ptr<Message::Header> SubSocket::ReceiveHeader(int flags) { return nullptr; }
+bool SubSocket::ReceiveTopic(std::string &topic, int flags) { return false; }
+bool SubSocket::ReceiveHeader(Message::Header &hdr, int flags) { return false; }
 Message::Frame SubSocket::ReceiveFrames(size_t total_len, int flags) { return Message::Frame(); }
 
 std::vector<std::string>::iterator SubSocket::FindSubscription(const std::string &topic)
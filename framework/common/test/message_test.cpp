@@ -14,6 +14,7 @@
 #include <mapf/common/message_maker.h>
 #include <mapf/local_bus.h>
 #include <thread>
+#include <typeinfo>
 #include <unistd.h>
 MAPF_INITIALIZE_LOGGER
 namespace mapf {
@@ -156,6 +157,78 @@ void test4()
     std::cout << "f1: " << f1 << std::endl;
 }
 
+bool test5()
+{
+    std::cout << "START test5" << std::endl;
+    static mapf::MessageMaker<mapf::MessageTest1> maker1(mapf::MessageTest1::kTopicPrefix);
+    static mapf::MessageMaker<mapf::MessageTest2> maker2(mapf::MessageTest2::kTopicPrefix);
+    bool ok = true;
+
+    // the factory creates the message type registered for the topic prefix
+    auto m1 = mapf::MessageFactory::Instance().Create("test1.thor");
+    auto m2 = mapf::MessageFactory::Instance().Create("test2.hulk");
+    auto m3 = mapf::MessageFactory::Instance().Create("test3.loki");
+    auto m4 = mapf::MessageFactory::Instance().Create("test");
+    ok &= dynamic_cast<mapf::MessageTest1 *>(m1.get()) != nullptr;
+    ok &= dynamic_cast<mapf::MessageTest2 *>(m2.get()) != nullptr;
+    ok &= typeid(*m3) == typeid(mapf::Message) && typeid(*m4) == typeid(mapf::Message);
+
+    // a message of the same type is reused, otherwise a new one is created
+    mapf::Message::Frame f1(kTopic.size(), kTopic.data());
+    mapf::Message *reused = m1.get();
+    mapf::MessageFactory::Instance().Create(m1, "test1.odin", {f1});
+    ok &= m1.get() == reused && m1->topic() == "test1.odin" && m1->frame().str() == kTopic;
+    mapf::MessageFactory::Instance().Create(m1, "test2.odin", {f1});
+    ok &= dynamic_cast<mapf::MessageTest2 *>(m1.get()) != nullptr;
+    reused = m3.get();
+    mapf::MessageFactory::Instance().Create(m3, "base", {f1});
+    ok &= m3.get() == reused && m3->topic() == "base" && m3->frames().size() == 1;
+
+    std::cout << "END test5 " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+bool test6()
+{
+    std::cout << "START test6" << std::endl;
+    bool ok = true;
+
+    // the message length is kept up to date as frames are added, resized and cleared
+    mapf::Message m1("loki", {mapf::Message::Frame(10), mapf::Message::Frame(20)});
+    ok &= m1.len() == 30 && m1.header().len == 30;
+    m1.ResizeFrame(5);
+    ok &= m1.len() == 15 && m1.frames().back().len() == 5;
+    mapf::Message::Frame f1(kTopic.size(), kTopic.data());
+    m1.Add(std::move(f1));
+    ok &= m1.len() == 15 + kTopic.size() && f1.len() == 0 && f1.data() == nullptr;
+    m1.Clear();
+    ok &= m1.len() == 0 && m1.frames().empty();
+
+    // a caller-owned buffer is used without copying and released with the last frame copy
+    uint8_t buf[64] = {1, 2, 3};
+    std::shared_ptr<int> owner = std::make_shared<int>(0);
+    {
+        mapf::Message m2("thor", {mapf::Message::Frame(buf, sizeof(buf), owner)});
+        ok &= m2.frame().data() == buf && m2.len() == sizeof(buf) && owner.use_count() == 2;
+        // growing beyond the caller-owned buffer copies the data
+        m2.ResizeFrame(2 * sizeof(buf));
+        ok &= m2.frame().data() != buf && m2.frame().data()[2] == 3 &&
+              m2.frame().data()[sizeof(buf)] == 0 && m2.len() == 2 * sizeof(buf);
+    }
+    ok &= owner.use_count() == 1;
+
+    // growing a frame back within its capacity doesn't zero the data shared with its copies
+    mapf::Message m3("odin", {mapf::Message::Frame(kTopic.size(), kTopic.data())});
+    mapf::Message m4(m3);
+    m3.ResizeFrame(1);
+    m3.ResizeFrame(kTopic.size());
+    ok &= m4.frame().str() == kTopic && m3.frame().data() != m4.frame().data() &&
+          m3.frame().data()[0] == kTopic[0] && m3.frame().data()[1] == 0;
+
+    std::cout << "END test6 " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
 int main()
 {
     /*mapf::Logger::Instance().LoggerInit("message_test");
@@ -169,5 +242,8 @@ int main()
     test2();
     test3();
     test4();
+    if (!test5() || !test6()) {
+        return 1;
+    }
     return 0;
 }
@@ -233,6 +233,43 @@ public:
     }
 };
 
+// test sending a message with a large frame in zero-copy mode
+class SocketTestMessageZeroCopy : public SocketTest {
+public:
+    SocketTestMessageZeroCopy(mapf::Context &ctx, SocketTestConfig *cfg = nullptr)
+        : SocketTest(ctx, cfg, "SocketTestMessageZeroCopy")
+    {
+        pub_.SetZeroCopy(true);
+    }
+
+    void Send() override
+    {
+        mapf::Message::Frame data(kFrameLength);
+        for (size_t i = 0; i < data.len(); i++)
+            data.data()[i] = uint8_t(i);
+        mapf::Message msg(kTopic, {data});
+
+        bool rc = pub_.Send(msg);
+        mapf_assert(rc == true);
+    }
+
+    void Recv() override
+    {
+        mapf::Message msg;
+        bool rc = sub_.Receive(msg);
+        mapf_assert(rc == true);
+        mapf_assert(msg.len() == kFrameLength);
+        auto frame = msg.frame();
+        for (size_t i = 0; i < kFrameLength; i++)
+            mapf_assert(frame.data()[i] == uint8_t(i));
+        if (cfg_.verbose)
+            MAPF_INFO("received zero-copy message: " << msg);
+    }
+
+private:
+    static const size_t kFrameLength = 4 * mapf::PubSocket::kZeroCopyMinFrameLength;
+};
+
 SocketTest::SocketTestConfig g_cfg;
 std::string g_test = "all";
 
@@ -241,7 +278,7 @@ void PrintHelp()
     std::cout << "-d/--delay <us>: Init delay (wait before start test)\n"
                  "-i/--iterations <num>: Iterations for each test case\n"
                  "-a/--attempts <num>: Max attempts for slow joiner WA\n"
-                 "-t/--test <name>: Test to run (all | string | frame | message | mult | factory)\n"
+                 "-t/--test <name>: Test to run (all | string | frame | message | mult | factory | zerocopy)\n"
                  "-v/--verbose: Enable verbose printing\n"
                  "-h/--help: Show help\n";
     exit(1);
@@ -277,7 +314,7 @@ void ProcessArgs(int argc, char **argv)
         case 't':
             g_test = std::string(optarg);
             if (g_test != "all" && g_test != "string" && g_test != "frame" && g_test != "message" &&
-                g_test != "mult" && g_test != "factory") {
+                g_test != "mult" && g_test != "factory" && g_test != "zerocopy") {
                 std::cout << "Invalid test name: " << g_test << std::endl;
                 PrintHelp();
             }
@@ -363,6 +400,12 @@ int main(int argc, char *argv[])
         test_factory.Run();
     }
 
+    if (g_test == "all" || g_test == "zerocopy") {
+        MAPF_INFO("Socket test message zero-copy start");
+        SocketTestMessageZeroCopy test_zero_copy(ctx, &g_cfg);
+        test_zero_copy.Run();
+    }
+
     kill(pid, SIGTERM);
     return 0;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include "msglib.h"
 #include <algorithm>
+#include <cstddef>
 #include <mapf/common/err.h>
 #include <mapf/common/logger.h>
 #include <mapf/common/message_factory.h>
@@ -98,6 +99,36 @@ size_t PubSocket::Send(void *buf, size_t len, int flags)
     return -1;
 }
 
+static void zero_copy_frame_free(void *data, void *hint)
+{
+    // hint holds a reference to the frame buffer, released once zmq is done with the data
+    delete static_cast<Message::Frame *>(hint);
+}
+
+bool PubSocket::SendFrame(const Message::Frame &frame, int flags)
+{
+    if (!zero_copy_ || frame.len() < kZeroCopyMinFrameLength) {
+        return Send(frame.data(), frame.len(), flags) == frame.len();
+    }
+
+    zmq_msg_t zmsg;
+    auto ref = new Message::Frame(frame);
+    int rc   = zmq_msg_init_data(&zmsg, ref->data(), ref->len(), zero_copy_frame_free, ref);
+    if (rc) {
+        delete ref;
+        return false;
+    }
+
+    int nbytes = zmq_msg_send(&zmsg, sock->sd_, flags);
+    if (nbytes < 0) {
+        // on failure the message is still owned by us, closing it releases the frame reference
+        zmq_msg_close(&zmsg);
+        return false;
+    }
+
+    return size_t(nbytes) == frame.len();
+}
+
 bool PubSocket::Send(const Message &msg, int flags)
 {
     mapf_assert(msg.version() == Message::kMessageHeaderVersion);
@@ -126,10 +157,9 @@ bool PubSocket::Send(const Message &msg, int flags)
     }
 
     // Finally, Send all data frames
-    for (auto frame : msg.frames()) {
-        flags  = (--nframes) ? flags | ZMQ_SNDMORE : flags & ~ZMQ_SNDMORE;
-        nbytes = Send(frame.data(), frame.len(), flags);
-        if (nbytes != frame.len()) {
+    for (const auto &frame : msg.frames()) {
+        flags = (--nframes) ? flags | ZMQ_SNDMORE : flags & ~ZMQ_SNDMORE;
+        if (!SendFrame(frame, flags)) {
             MAPF_ERR("message send failed, errno=" << strerror(errno));
             return false;
         }
@@ -228,29 +258,27 @@ bool SubSocket::Receive(Message &msg, int flags)
     msg.Clear();
 
     /** first, receive the topic */
-    auto topic = ReceiveTopic(flags);
-    if (topic == nullptr)
+    if (!ReceiveTopic(rx_topic_, flags))
         return false;
-    msg.set_topic(*topic);
+    msg.set_topic(rx_topic_);
 
     if (false == More())
         return true; // message with topic only, allowed
 
     /** next, receive the header */
-    auto hdr = ReceiveHeader(flags);
-    if (hdr == nullptr)
+    Message::Header hdr;
+    if (!ReceiveHeader(hdr, flags))
         return false;
 
     if (false == More()) {
-        mapf_assert(hdr->len == 0);
+        mapf_assert(hdr.len == 0);
         DBG("message with topic only received");
         return true; // message with header only, allowed
     }
 
     /** finally, receive all the rest of the message parts to a
 	 *  single frame */
-    Message::Frame frame = ReceiveFrames(hdr->len, flags);
-    msg.Add(frame);
+    msg.Add(ReceiveFrames(hdr.len, flags));
 
     DBG("message received");
     return true;
@@ -258,70 +286,103 @@ bool SubSocket::Receive(Message &msg, int flags)
 
 std::unique_ptr<Message> SubSocket::Receive(int flags)
 {
-    /** first, receive the topic */
-    auto topic = ReceiveTopic(flags);
-    if (topic == nullptr)
+    std::unique_ptr<Message> msg;
+    if (!Receive(msg, flags))
         return nullptr;
 
+    return msg;
+}
+
+bool SubSocket::Receive(std::unique_ptr<Message> &msg, int flags)
+{
+    /** first, receive the topic */
+    if (!ReceiveTopic(rx_topic_, flags))
+        return false;
+
     /** next, receive the header */
-    auto hdr = ReceiveHeader(flags);
-    if (hdr == nullptr)
-        return nullptr;
+    Message::Header hdr;
+    if (!ReceiveHeader(hdr, flags))
+        return false;
 
     if (false == More()) {
-        mapf_assert(hdr->len == 0);
+        mapf_assert(hdr.len == 0);
         DBG("message with topic only received");
-        return MessageFactory::Instance().Create(*topic); // message with header only, allowed
+        MessageFactory::Instance().Create(msg, rx_topic_, {}); // message with header only, allowed
+        return true;
     }
 
     /** finally, receive all the rest of the message parts to a
 	 *  single frame */
-    Message::Frame frame = ReceiveFrames(hdr->len, flags);
     DBG("message received");
-    return MessageFactory::Instance().Create(*topic, {frame});
+    MessageFactory::Instance().Create(msg, rx_topic_, {ReceiveFrames(hdr.len, flags)});
+    return true;
 }
 
 /* SUB Socket Private */
-std::unique_ptr<std::string> SubSocket::ReceiveTopic(int flags)
+bool SubSocket::ReceiveTopic(std::string &topic, int flags)
 {
-    char topic[Message::kMaxTopicSize];
-    int nbytes = Receive(topic, sizeof(topic) - 1, flags);
+    char buf[Message::kMaxTopicSize];
+    ssize_t nbytes = Receive(buf, sizeof(buf), flags);
     if (nbytes == -1) {
         MAPF_ERR("topic receive failed, errno=" << strerror(errno));
-        return nullptr;
+        return false;
     }
-    topic[nbytes] = 0;
+    // the topic is truncated if it is too long
+    topic.assign(buf, strnlen(buf, std::min(size_t(nbytes), sizeof(buf) - 1)));
     DBG("received topic=" << topic);
-    return std::unique_ptr<std::string>(new std::string(topic));
+    return true;
 }
 
-std::unique_ptr<Message::Header> SubSocket::ReceiveHeader(int flags)
+bool SubSocket::ReceiveHeader(Message::Header &hdr, int flags)
 {
-    Message::Header hdr;
     ssize_t nbytes = Receive(&hdr, sizeof(hdr), flags);
     if (nbytes == -1) {
         MAPF_ERR("header receive failed, errno=" << strerror(errno));
-        return nullptr;
+        return false;
     }
     DBG("received header len=" << hdr.len << " more=" << More());
     // we do not support different header versions YET
     mapf_assert(hdr.version == Message::kMessageHeaderVersion);
     mapf_assert(hdr.len <= Message::kMaxFrameLength);
-    return std::unique_ptr<Message::Header>(new Message::Header(hdr));
+    return true;
+}
+
+static void zero_copy_msg_close(zmq_msg_t *zmsg)
+{
+    zmq_msg_close(zmsg);
+    delete zmsg;
 }
 
 Message::Frame SubSocket::ReceiveFrames(size_t total_len, int flags)
 {
+    // the frames of a message are usually sent as a single part, in which case a large enough
+    // received part is used as the frame data instead of copying it (if it is aligned like a heap
+    // buffer, since frames are cast to structs)
+    std::shared_ptr<zmq_msg_t> zmsg(new zmq_msg_t, zero_copy_msg_close);
+    zmq_msg_init(zmsg.get());
+    if (zmq_msg_recv(zmsg.get(), sock->sd_, flags) < 0) {
+        MAPF_ERR("frame receive failed, errno=" << strerror(errno));
+        return Message::Frame();
+    }
+    size_t len = zmq_msg_size(zmsg.get());
+    mapf_assert(len <= total_len); //total length mismatch!
+    void *data = zmq_msg_data(zmsg.get());
+    if (!zmq_msg_more(zmsg.get()) && len >= PubSocket::kZeroCopyMinFrameLength &&
+        reinterpret_cast<uintptr_t>(data) % alignof(std::max_align_t) == 0) {
+        mapf_assert(len == total_len);
+        return Message::Frame(data, len, zmsg);
+    }
+
     Message::Frame frame(total_len);
     uint8_t *ptr = frame.data();
-    size_t len   = 0;
-    do {
+    std::copy_n(static_cast<uint8_t *>(data), len, ptr);
+    while (More()) {
         len += Receive(ptr + len, total_len - len, flags);
         mapf_assert(len <= total_len); //total length mismatch!
-    } while (More());
+    }
 
     mapf_assert(len == total_len);
-    return frame; // allowed since Message::Frame contains a shared pointer
+    return frame;
 }
 
 bool SubSocket::More() const
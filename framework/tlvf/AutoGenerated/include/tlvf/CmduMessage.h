@@ -12,6 +12,7 @@
 #ifndef _CmduMessage_H_
 #define _CmduMessage_H_
 
+#include "ClassArena.h"
 #include "ieee_1905_1/cCmduHeader.h"
 #include "ieee_1905_1/eTlvType.h"
 #include <memory>
@@ -33,9 +34,9 @@ public:
         std::shared_ptr<T> ptr;
         if (m_cmdu_header) {
             if (m_class_vector.size() == 0) {
-                ptr = std::make_shared<T>(m_cmdu_header, m_parse, m_swap);
+                ptr = m_arena.make_shared<T>(m_cmdu_header, m_parse, m_swap);
             } else {
-                ptr = std::make_shared<T>(m_class_vector.back(), m_parse, m_swap);
+                ptr = m_arena.make_shared<T>(m_class_vector.back(), m_parse, m_swap);
             }
             if (!ptr || ptr->isInitialized() == false) {
                 return std::shared_ptr<T>();
@@ -86,10 +87,13 @@ protected:
     bool m_swap                  = false;
     bool m_dynamically_allocated = false;
     uint8_t *m_buff              = nullptr;
+    // Backing memory of the header and classes, must outlive them
+    ClassArena m_arena;
     std::shared_ptr<cCmduHeader> m_cmdu_header;
     std::vector<std::shared_ptr<BaseClass>> m_class_vector;
     static const uint16_t kCmduHeaderLength = 8;
     static const uint16_t kTlvHeaderLength  = 3;
+    static const size_t kClassVectorReserve = 16;
 };
 
 }; // close namespace: ieee1905_1
@@ -50,6 +50,9 @@ class tlv1905NeighborDevice : public BaseClass
         } __attribute__((packed)) sMacAl1905Device;
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_1905_NEIGHBOR_DEVICE;
+        }
         const uint16_t& length();
         sMacAddr& mac_local_iface();
         std::tuple<bool, sMacAl1905Device&> mac_al_1905_device(size_t idx);
@@ -33,6 +33,9 @@ class tlvAlMacAddressType : public BaseClass
         ~tlvAlMacAddressType();
 
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_AL_MAC_ADDRESS_TYPE;
+        }
         const uint16_t& length();
         sMacAddr& mac();
         void class_swap();
@@ -38,6 +38,9 @@ class tlvAutoconfigFreqBand : public BaseClass
         };
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_AUTOCONFIG_FREQ_BAND;
+        }
         const uint16_t& length();
         eValue& value();
         void class_swap();
@@ -36,6 +36,9 @@ class tlvDeviceBridgingCapability : public BaseClass
         ~tlvDeviceBridgingCapability();
 
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_DEVICE_BRIDGING_CAPABILITY;
+        }
         const uint16_t& length();
         uint8_t& bridging_tuples_list_length();
         std::tuple<bool, cMacList&> bridging_tuples_list(size_t idx);
@@ -48,6 +48,9 @@ class tlvDeviceInformation : public BaseClass
         } __attribute__((packed)) sInfo;
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_DEVICE_INFORMATION;
+        }
         const uint16_t& length();
         sMacAddr& mac();
         uint8_t& info_length();
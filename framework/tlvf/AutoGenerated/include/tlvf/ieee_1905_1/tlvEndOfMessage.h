@@ -32,6 +32,9 @@ class tlvEndOfMessage : public BaseClass
         ~tlvEndOfMessage();
 
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_END_OF_MESSAGE;
+        }
         const uint16_t& length();
         void class_swap();
         static size_t get_initial_size();
@@ -44,6 +44,9 @@ class tlvLinkMetricQuery : public BaseClass
         };
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_LINK_METRIC_QUERY;
+        }
         const uint16_t& length();
         eNeighborType& neighbor_type();
         sMacAddr& mac_al_1905_device();
@@ -36,6 +36,9 @@ class tlvLinkMetricResultCode : public BaseClass
         };
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_LINK_METRIC_RESULT_CODE;
+        }
         const uint16_t& length();
         eValue& value();
         void class_swap();
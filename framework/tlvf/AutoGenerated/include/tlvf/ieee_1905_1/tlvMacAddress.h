@@ -33,6 +33,9 @@ class tlvMacAddress : public BaseClass
         ~tlvMacAddress();
 
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_MAC_ADDRESS;
+        }
         const uint16_t& length();
         std::tuple<bool, uint8_t&> mac(size_t idx);
         void class_swap();
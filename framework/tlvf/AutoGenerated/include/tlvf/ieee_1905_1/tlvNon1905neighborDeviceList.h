@@ -34,6 +34,9 @@ class tlvNon1905neighborDeviceList : public BaseClass
         ~tlvNon1905neighborDeviceList();
 
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_NON_1905_NEIGHBOR_DEVICE_LIST;
+        }
         const uint16_t& length();
         sMacAddr& mac_local_iface();
         std::tuple<bool, sMacAddr&> mac_non_1905_device(size_t idx);
@@ -47,6 +47,9 @@ class tlvPushButtonEventNotification : public BaseClass
         } __attribute__((packed)) sMediaType;
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_PUSH_BUTTON_EVENT_NOTIFICATION;
+        }
         const uint16_t& length();
         uint8_t& media_type_list_length();
         std::tuple<bool, sMediaType&> media_type_list(size_t idx);
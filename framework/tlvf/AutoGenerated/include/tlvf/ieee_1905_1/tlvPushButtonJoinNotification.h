@@ -33,6 +33,9 @@ class tlvPushButtonJoinNotification : public BaseClass
         ~tlvPushButtonJoinNotification();
 
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_PUSH_BUTTON_JOIN_NOTIFICATION;
+        }
         const uint16_t& length();
         sMacAddr& al_mac_notification_src();
         uint16_t& mid_of_the_notification();
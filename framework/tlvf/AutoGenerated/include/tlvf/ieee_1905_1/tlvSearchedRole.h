@@ -36,6 +36,9 @@ class tlvSearchedRole : public BaseClass
         };
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_SEARCHED_ROLE;
+        }
         const uint16_t& length();
         eValue& value();
         void class_swap();
@@ -38,6 +38,9 @@ class tlvSupportedFreqBand : public BaseClass
         };
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_SUPPORTED_FREQ_BAND;
+        }
         const uint16_t& length();
         eValue& value();
         void class_swap();
@@ -84,6 +84,9 @@ class tlvTransmitterLinkMetric : public BaseClass
         } __attribute__((packed)) sInterfacePairInfo;
         
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_TRANSMITTER_LINK_METRIC;
+        }
         const uint16_t& length();
         sMacAddr& al_mac_of_the_device_that_transmits();
         sMacAddr& al_mac_of_the_neighbor_whose_link_metric_is_reported_in_this_tlv();
@@ -33,6 +33,9 @@ class tlvWscM1 : public BaseClass
         ~tlvWscM1();
 
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_WSC;
+        }
         const uint16_t& length();
         WSC::sM1& M1Frame();
         void class_swap();
@@ -33,6 +33,9 @@ class tlvWscM2 : public BaseClass
         ~tlvWscM2();
 
         const eTlvType& type();
+        static eTlvType get_type(){
+            return eTlvType::TLV_WSC;
+        }
         const uint16_t& length();
         WSC::sM2& M2Frame();
         void class_swap();
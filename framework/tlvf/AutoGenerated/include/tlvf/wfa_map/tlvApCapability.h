@@ -54,6 +54,9 @@ class tlvApCapability : public BaseClass
         } __attribute__((packed)) sValue;
         
         const eTlvTypeMap& type();
+        static eTlvTypeMap get_type(){
+            return eTlvTypeMap::TLV_AP_CAPABILITY;
+        }
         const uint16_t& length();
         sValue& value();
         void class_swap();
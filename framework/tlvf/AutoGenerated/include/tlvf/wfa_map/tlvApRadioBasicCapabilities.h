@@ -36,6 +36,9 @@ class tlvApRadioBasicCapabilities : public BaseClass
         ~tlvApRadioBasicCapabilities();
 
         const eTlvTypeMap& type();
+        static eTlvTypeMap get_type(){
+            return eTlvTypeMap::TLV_AP_RADIO_BASIC_CAPABILITIES;
+        }
         const uint16_t& length();
         sMacAddr& radio_uid();
         uint8_t& maximum_number_of_bsss_supported();
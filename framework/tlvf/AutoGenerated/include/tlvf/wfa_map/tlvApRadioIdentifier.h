@@ -33,6 +33,9 @@ class tlvApRadioIdentifier : public BaseClass
         ~tlvApRadioIdentifier();
 
         const eTlvTypeMap& type();
+        static eTlvTypeMap get_type(){
+            return eTlvTypeMap::TLV_AP_RADIO_IDENTIFIER;
+        }
         const uint16_t& length();
         sMacAddr& radio_uid();
         void class_swap();
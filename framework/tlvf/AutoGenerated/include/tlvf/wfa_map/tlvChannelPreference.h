@@ -37,6 +37,9 @@ class tlvChannelPreference : public BaseClass
         ~tlvChannelPreference();
 
         const eTlvTypeMap& type();
+        static eTlvTypeMap get_type(){
+            return eTlvTypeMap::TLV_CHANNEL_PREFERENCE;
+        }
         const uint16_t& length();
         sMacAddr& radio_uid();
         uint8_t& operating_classes_list_length();
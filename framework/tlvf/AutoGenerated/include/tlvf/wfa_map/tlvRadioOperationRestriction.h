@@ -36,6 +36,9 @@ class tlvRadioOperationRestriction : public BaseClass
         ~tlvRadioOperationRestriction();
 
         const eTlvTypeMap& type();
+        static eTlvTypeMap get_type(){
+            return eTlvTypeMap::TLV_RADIO_OPERATION_RESTRICTION;
+        }
         const uint16_t& length();
         sMacAddr& radio_uid();
         uint8_t& operating_classes_list_length();
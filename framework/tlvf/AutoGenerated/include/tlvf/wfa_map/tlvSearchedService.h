@@ -37,6 +37,9 @@ class tlvSearchedService : public BaseClass
         };
         
         const eTlvTypeMap& type();
+        static eTlvTypeMap get_type(){
+            return eTlvTypeMap::TLV_SEARCHED_SERVICE;
+        }
         const uint16_t& length();
         uint8_t& searched_service_list_length();
         std::tuple<bool, eSearchedService&> searched_service_list(size_t idx);
@@ -38,6 +38,9 @@ class tlvSupportedService : public BaseClass
         };
         
         const eTlvTypeMap& type();
+        static eTlvTypeMap get_type(){
+            return eTlvTypeMap::TLV_SUPPORTED_SERVICE;
+        }
         const uint16_t& length();
         uint8_t& supported_service_list_length();
         std::tuple<bool, eSupportedService&> supported_service_list(size_t idx);
@@ -13,7 +13,7 @@
 
 using namespace ieee1905_1;
 
-CmduMessage::CmduMessage() {}
+CmduMessage::CmduMessage() { m_class_vector.reserve(kClassVectorReserve); }
 
 CmduMessage::~CmduMessage() {}
 
@@ -135,6 +135,7 @@ void CmduMessage::reset()
         c.reset();
     }
     m_class_vector.clear();
+    m_arena.reset();
 }
 
 eMessageType CmduMessage::getMessageType()
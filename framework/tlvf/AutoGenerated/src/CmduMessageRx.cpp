@@ -10,6 +10,7 @@
  */
 
 #include <tlvf/CmduMessageRx.h>
+#include <tlvf/tlvflogging.h>
 
 using namespace ieee1905_1;
 
@@ -41,15 +42,54 @@ CmduMessageRx::~CmduMessageRx()
 
 std::shared_ptr<cCmduHeader> CmduMessageRx::parse(uint8_t *buff, size_t buff_len, bool swap_needed)
 {
+    // release the lazily created classes before the arena is reset
+    m_tlv_index.clear();
     reset();
+    m_tlv_indexed = false;
     m_parse       = true;
     m_swap        = swap_needed;
     m_buff        = buff;
     m_buff_len    = buff_len;
-    m_cmdu_header = std::make_shared<cCmduHeader>(buff, buff_len, true, false);
+    m_cmdu_header = m_arena.make_shared<cCmduHeader>(buff, buff_len, true, false);
     if (!m_cmdu_header || m_cmdu_header->isInitialized() == false) {
         m_cmdu_header = nullptr;
     }
 
     return m_cmdu_header;
 }
+
+bool CmduMessageRx::index_tlvs()
+{
+    if (m_tlv_indexed) {
+        return true;
+    }
+    if (!m_cmdu_header) {
+        return false;
+    }
+
+    size_t offset = m_cmdu_header->getLen();
+    while (offset + kTlvHeaderLength <= m_buff_len) {
+        sTlvIndexEntry entry;
+        entry.type   = m_buff[offset];
+        entry.length = *((uint16_t *)(m_buff + offset + sizeof(uint8_t)));
+        entry.offset = offset;
+        if (m_swap) {
+            swap_16((uint16_t &)entry.length);
+        }
+        if (offset + kTlvHeaderLength + entry.length > m_buff_len) {
+            TLVF_LOG(ERROR) << "TLV " << int(entry.type) << " length " << entry.length
+                            << " exceeds the message buffer";
+            return false;
+        }
+        m_tlv_index.push_back(entry);
+        if (entry.type == uint8_t(eTlvType::TLV_END_OF_MESSAGE)) {
+            break;
+        }
+        offset += kTlvHeaderLength + entry.length;
+    }
+
+    m_tlv_indexed = true;
+    return true;
+}
+
+size_t CmduMessageRx::getTlvCount() { return index_tlvs() ? m_tlv_index.size() : 0; }
@@ -30,7 +30,7 @@ std::shared_ptr<cCmduHeader> CmduMessageTx::create(uint16_t id, eMessageType mes
     m_parse = false;
     memset(m_buff, 0, m_buff_len);
     reset();
-    m_cmdu_header = std::make_shared<cCmduHeader>(m_buff, m_buff_len);
+    m_cmdu_header = m_arena.make_shared<cCmduHeader>(m_buff, m_buff_len);
     if (!m_cmdu_header || m_cmdu_header->isInitialized() == false) {
         return nullptr;
     }
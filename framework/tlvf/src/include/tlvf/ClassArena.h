@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _ClassArena_H_
+#define _ClassArena_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ieee1905_1 {
+
+/*
+ * Bump allocator for the classes (header, TLVs) which are attached to a CmduMessage.
+ * Instead of a separate heap allocation per class (std::make_shared), the class and its
+ * shared_ptr control block are carved out of a chunk owned by the message. The chunk is
+ * rewound when the message is reset and nobody else holds a class allocated from it.
+ *
+ * Each chunk is reference counted by its live allocations (plus the arena itself while it
+ * is the current chunk), so a shared_ptr which outlives the reset() of the message, or the
+ * message itself, stays valid - its chunk is freed when the last allocation is released.
+ */
+class ClassArena {
+public:
+    static const size_t kDefaultChunkSize = 4096;
+
+    explicit ClassArena(size_t chunk_size = kDefaultChunkSize);
+    // Copying a message does not share its arena, the copy starts with an empty one
+    ClassArena(const ClassArena &other);
+    ClassArena &operator=(const ClassArena &other);
+    ~ClassArena();
+
+    void *allocate(size_t size);
+    static void deallocate(void *ptr);
+    void reset();
+
+    template <class T> class Allocator {
+    public:
+        typedef T value_type;
+
+        explicit Allocator(ClassArena *arena) : m_arena(arena) {}
+        template <class U> Allocator(const Allocator<U> &other) : m_arena(other.m_arena) {}
+
+        T *allocate(size_t n) { return static_cast<T *>(m_arena->allocate(n * sizeof(T))); }
+        void deallocate(T *ptr, size_t n) { ClassArena::deallocate(ptr); }
+
+        template <class U> bool operator==(const Allocator<U> &other) const
+        {
+            return m_arena == other.m_arena;
+        }
+        template <class U> bool operator!=(const Allocator<U> &other) const
+        {
+            return m_arena != other.m_arena;
+        }
+
+    private:
+        template <class U> friend class Allocator;
+        ClassArena *m_arena;
+    };
+
+    template <class T, class... Args> std::shared_ptr<T> make_shared(Args &&... args)
+    {
+        return std::allocate_shared<T>(Allocator<T>(this), std::forward<Args>(args)...);
+    }
+
+private:
+    struct sChunk {
+        std::atomic<uint32_t> refs;
+        size_t size;
+        size_t used;
+    };
+
+    sChunk *new_chunk(size_t size);
+    static void release(sChunk *chunk);
+
+    const size_t m_chunk_size;
+    sChunk *m_chunk = nullptr;
+};
+
+}; // close namespace: ieee1905_1
+
+#endif //_ClassArena_H_
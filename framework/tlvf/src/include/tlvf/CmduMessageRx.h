@@ -14,6 +14,8 @@
 
 #include "CmduMessage.h"
 
+#include <vector>
+
 namespace ieee1905_1 {
 
 class CmduMessageRx : public CmduMessage {
@@ -26,6 +28,71 @@ public:
 public:
     std::shared_ptr<cCmduHeader> parse(uint8_t *buff, size_t buff_len, bool swap_needed = true);
     CmduMessageRx &operator=(const CmduMessageRx &) = delete;
+
+    /*
+     * Lazy TLV access, an alternative to the addClass() chain.
+     * On the first call the TLVs following the header are indexed (type, offset, length) in a
+     * single pass, and only the requested TLV class is instantiated (and swapped).
+     * Classes returned from getTlv() are not part of the class vector, so the same TLV
+     * should not also be parsed with addClass().
+     */
+    template <class T> std::shared_ptr<T> getTlv()
+    {
+        if (!index_tlvs()) {
+            return nullptr;
+        }
+        for (auto &entry : m_tlv_index) {
+            if (entry.type == uint8_t(T::get_type())) {
+                return instantiate_tlv<T>(entry);
+            }
+        }
+        return nullptr;
+    }
+
+    template <class T> std::vector<std::shared_ptr<T>> getTlvList()
+    {
+        std::vector<std::shared_ptr<T>> tlvs;
+        if (!index_tlvs()) {
+            return tlvs;
+        }
+        for (auto &entry : m_tlv_index) {
+            if (entry.type == uint8_t(T::get_type())) {
+                auto tlv = instantiate_tlv<T>(entry);
+                if (tlv) {
+                    tlvs.push_back(tlv);
+                }
+            }
+        }
+        return tlvs;
+    }
+
+    size_t getTlvCount();
+
+private:
+    struct sTlvIndexEntry {
+        uint8_t type;
+        uint16_t length;
+        size_t offset;
+        std::shared_ptr<BaseClass> instance;
+    };
+
+    bool index_tlvs();
+
+    template <class T> std::shared_ptr<T> instantiate_tlv(sTlvIndexEntry &entry)
+    {
+        if (!entry.instance) {
+            auto ptr = m_arena.make_shared<T>(m_buff + entry.offset, m_buff_len - entry.offset,
+                                              true, m_swap);
+            if (!ptr || ptr->isInitialized() == false) {
+                return nullptr;
+            }
+            entry.instance = ptr;
+        }
+        return std::dynamic_pointer_cast<T>(entry.instance);
+    }
+
+    bool m_tlv_indexed = false;
+    std::vector<sTlvIndexEntry> m_tlv_index;
 };
 
 }; // close namespace: ieee1905_1
@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <tlvf/ClassArena.h>
+
+#include <new>
+
+using namespace ieee1905_1;
+
+// Every allocation is prefixed by a pointer to its chunk, padded to keep the payload aligned
+static const size_t kAlignment  = alignof(std::max_align_t);
+static const size_t kPrefixSize = (sizeof(void *) + kAlignment - 1) & ~(kAlignment - 1);
+
+static size_t align_up(size_t size) { return (size + kAlignment - 1) & ~(kAlignment - 1); }
+
+ClassArena::ClassArena(size_t chunk_size) : m_chunk_size(chunk_size) {}
+
+ClassArena::ClassArena(const ClassArena &other) : m_chunk_size(other.m_chunk_size) {}
+
+ClassArena &ClassArena::operator=(const ClassArena &other) { return *this; }
+
+ClassArena::~ClassArena()
+{
+    if (m_chunk) {
+        release(m_chunk);
+    }
+}
+
+ClassArena::sChunk *ClassArena::new_chunk(size_t size)
+{
+    uint8_t *mem  = static_cast<uint8_t *>(::operator new(align_up(sizeof(sChunk)) + size));
+    sChunk *chunk = new (mem) sChunk;
+    chunk->refs   = 1;
+    chunk->size   = size;
+    chunk->used   = 0;
+    return chunk;
+}
+
+void ClassArena::release(sChunk *chunk)
+{
+    if (chunk->refs.fetch_sub(1) == 1) {
+        chunk->~sChunk();
+        ::operator delete(chunk);
+    }
+}
+
+void *ClassArena::allocate(size_t size)
+{
+    size_t needed = kPrefixSize + align_up(size);
+
+    sChunk *chunk;
+    if (needed > m_chunk_size) {
+        // Oversized class, give it a dedicated chunk which is not kept as the current one
+        chunk = new_chunk(needed);
+    } else {
+        if (!m_chunk || m_chunk->size - m_chunk->used < needed) {
+            if (m_chunk) {
+                release(m_chunk);
+            }
+            m_chunk = new_chunk(m_chunk_size);
+        }
+        chunk = m_chunk;
+        chunk->refs++;
+    }
+
+    uint8_t *ptr = reinterpret_cast<uint8_t *>(chunk) + align_up(sizeof(sChunk)) + chunk->used;
+    chunk->used += needed;
+    *reinterpret_cast<sChunk **>(ptr) = chunk;
+    return ptr + kPrefixSize;
+}
+
+void ClassArena::deallocate(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    release(*reinterpret_cast<sChunk **>(static_cast<uint8_t *>(ptr) - kPrefixSize));
+}
+
+void ClassArena::reset()
+{
+    if (!m_chunk) {
+        return;
+    }
+    if (m_chunk->refs == 1) {
+        // Only the arena references the chunk, it can be reused from the start
+        m_chunk->used = 0;
+    } else {
+        // Classes from the previous message are still held, leave the chunk to them
+        release(m_chunk);
+        m_chunk = nullptr;
+    }
+}
@@ -10,7 +10,7 @@
 
 using namespace ieee1905_1;
 
-CmduMessage::CmduMessage() {}
+CmduMessage::CmduMessage() { m_class_vector.reserve(kClassVectorReserve); }
 
 CmduMessage::~CmduMessage() {}
 
@@ -132,6 +132,7 @@ void CmduMessage::reset()
         c.reset();
     }
     m_class_vector.clear();
+    m_arena.reset();
 }
 
 eMessageType CmduMessage::getMessageType()
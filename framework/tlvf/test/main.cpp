@@ -216,5 +216,37 @@ int main(int argc, char *argv[])
         errors++;
     }
 
+    // Lazy parsing - only the requested TLVs are instantiated, in any order
+    uint8_t lazy_buffer[sizeof(tx_buffer)];
+    memcpy(lazy_buffer, tx_buffer, sizeof(lazy_buffer));
+
+    CmduMessageRx lazy_message;
+    lazy_message.parse(lazy_buffer, sizeof(lazy_buffer), true);
+    auto lazyTlv2 = lazy_message.getTlv<tlvLinkMetricQuery>();
+    auto lazyTlv1 = lazy_message.getTlv<tlvNon1905neighborDeviceList>();
+    if (lazy_message.getTlvCount() == 4 && lazyTlv2 && lazyTlv1 &&
+        lazyTlv2->link_metrics() == tlvLinkMetricQuery::eLinkMetricsType::RX_LINK_METRICS_ONLY &&
+        std::get<0>(lazyTlv1->mac_non_1905_device(2)) &&
+        !lazy_message.getTlv<tlv1905NeighborDevice>()) {
+        MAPF_INFO("LAZY PARSING SUCCESS");
+    } else {
+        MAPF_ERR("LAZY PARSING FAILED");
+        errors++;
+    }
+
+    // Classes are allocated from the message arena, a class which is still held when the
+    // message is created again must not be overwritten by the classes of the new message
+    uint8_t *held_tlv_buff = secondTlv->getStartBuffPtr();
+    for (int i = 0; i < 100; i++) {
+        msg.create(i, eMessageType::LINK_METRIC_QUERY_MESSAGE);
+        msg.addClass<tlvLinkMetricQuery>();
+    }
+    if (secondTlv->isInitialized() && secondTlv->getStartBuffPtr() == held_tlv_buff) {
+        MAPF_INFO("ARENA HELD CLASS SUCCESS");
+    } else {
+        MAPF_ERR("ARENA HELD CLASS FAILED");
+        errors++;
+    }
+
     return errors;
 }
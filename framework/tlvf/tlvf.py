@@ -662,6 +662,10 @@ class TlvF:
                 # add function to return reference
                 const = "const " if param_val_const != None or (self.is_tlv_class and param_name == MetaData.TLV_TYPE_LENGTH) else ""
                 lines_h.append( "%s%s& %s();" % (const, param_type, param_name) ) #const
+                if self.is_tlv_class and param_name == MetaData.TLV_TYPE_TYPE and param_val_const != None:
+                    lines_h.append( "static %s get_%s(){" % (param_type, param_name) )
+                    lines_h.append( "%sreturn %s;" % (self.getIndentation(1), param_val_const) )
+                    lines_h.append( "}" )
                 lines_cpp.append( "%s%s& %s::%s() {" % (const, param_type_full, obj_meta.name, param_name) )
                 lines_cpp.append( "%sreturn (%s%s&)(*m_%s);" % (self.getIndentation(1), const, param_type, param_name) )
                 lines_cpp.append( "}" )
@@ -19,6 +19,8 @@ void Ieee1905Transport::run()
     // init Local Bus interface, subscribe to specific topics
     local_bus_ = new LocalBusInterface(Context::Instance());
     local_bus_->Init();
+    // messages published by the transport are never modified after being sent
+    local_bus_->publisher().SetZeroCopy(true);
     if (local_bus_->subscriber().Subscribe<CmduTxMessage>() < 0) {
         MAPF_ERR("cannot subscribe to local bus.");
         return;
@@ -82,7 +84,11 @@ void Ieee1905Transport::run()
                 auto revents = poller_.CheckEvent(network_interface.fd);
                 if (revents & MAPF_POLLIN) {
                     MAPF_DBG("got MAPF_POLLIN event on interface " << if_index << ".");
-                    handle_interface_pollin_event(network_interface.fd);
+                    if (network_interface.rx_ring) {
+                        handle_interface_rx_ring_event(network_interface);
+                    } else {
+                        handle_interface_pollin_event(network_interface.fd);
+                    }
                 }
                 if (revents & MAPF_POLLERR) {
                     // this could happen whenever an interface comes down
@@ -14,7 +14,12 @@ namespace mapf {
 
 void Ieee1905Transport::handle_local_bus_pollin_event()
 {
-    auto msg = local_bus_->subscriber().Receive();
+    // the message object is reused between received messages (of the same type)
+    if (!local_bus_->subscriber().Receive(local_bus_rx_msg_)) {
+        MAPF_ERR("cannot receive message from local bus.");
+        return;
+    }
+    auto &msg = local_bus_rx_msg_;
 
     if (auto *cmdu_tx_msg = dynamic_cast<CmduTxMessage *>(msg.get())) {
         MAPF_DBG("received CmduTxMessage message:" << std::endl << *cmdu_tx_msg);
@@ -115,6 +120,8 @@ void Ieee1905Transport::handle_local_bus_interface_configuration_request_message
             msg.metadata()->interfaces[i].bridge_if_index;
         updated_network_interfaces[if_index].is_bridge =
             msg.metadata()->interfaces[i].flags & Flags::IS_BRIDGE;
+        updated_network_interfaces[if_index].use_rx_ring =
+            msg.metadata()->interfaces[i].flags & Flags::ENABLE_RX_RING;
     }
 
     update_network_interfaces(updated_network_interfaces);
@@ -125,7 +132,7 @@ void Ieee1905Transport::handle_local_bus_interface_configuration_request_message
 bool Ieee1905Transport::send_packet_to_local_bus(Packet &packet)
 {
     // create and fill an CmduRxMessage to be sent on the local bus
-    CmduRxMessage msg;
+    CmduRxMessage msg(packet.payload.iov_len);
 
     std::copy_n(packet.src, ETH_ALEN, msg.metadata()->src);
     std::copy_n(packet.dst, ETH_ALEN, msg.metadata()->dst);
@@ -133,7 +140,6 @@ bool Ieee1905Transport::send_packet_to_local_bus(Packet &packet)
     msg.metadata()->ether_type = packet.ether_type;
     msg.metadata()->if_type    = packet.src_if_type;
     msg.metadata()->if_index   = packet.src_if_index;
-    msg.metadata()->length     = packet.payload.iov_len;
     std::copy_n((uint8_t *)packet.payload.iov_base, packet.payload.iov_len, msg.data());
 
     if (packet.ether_type == ETH_P_1905_1) {
@@ -174,6 +180,9 @@ void Ieee1905Transport::publish_interface_configuration_indication()
         } else {
             indication_msg.metadata()->interfaces[n].flags |= Flags::ENABLE_IEEE1905_TRANSPORT;
         }
+        if (network_interface.use_rx_ring) {
+            indication_msg.metadata()->interfaces[n].flags |= Flags::ENABLE_RX_RING;
+        }
 
         n++;
     }
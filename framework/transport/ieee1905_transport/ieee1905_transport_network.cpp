@@ -9,13 +9,17 @@
 #include <mapf/transport/ieee1905_transport.h>
 
 #include <arpa/inet.h>
+#include <atomic>
 #include <iomanip>
+#include <linux/bpf.h>
 #include <linux/filter.h>
+#include <linux/if_packet.h>
 #include <net/if.h>
 #include <netinet/ether.h>
-#include <netpacket/packet.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
+#include <sys/syscall.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
@@ -23,9 +27,8 @@ namespace mapf {
 
 // helper class to manage socket filter programs (Berkely Socket Filter)
 //
-// Note: I chose to use here the classic BPF implementation. Once all targets move to kernel version >= 3.19
-// this code and the Ieee1905SocketFilter class could be migrated to the extended BPF (eBPF) system - see bpf(2)
-// http://man7.org/linux/man-pages/man2/bpf.2.html
+// Note: this is the classic BPF implementation, which is used when the extended BPF (eBPF) program
+// of Ieee1905EbpfSocketFilter cannot be loaded (kernel version < 3.19 or missing privileges).
 class Ieee1905SocketFilter {
 public:
     // create a filter that accepts packets that match the basic transport requirements - see below.
@@ -42,13 +45,13 @@ public:
         if (!addr1)
             addr1 = ieee1905_multicast_address;
 
-        filter[4].k = (uint32_t)addr0[2] << 24 | (uint32_t)addr0[3] << 16 |
+        filter[6].k = (uint32_t)addr0[2] << 24 | (uint32_t)addr0[3] << 16 |
                       (uint32_t)addr0[4] << 8 | (uint32_t)addr0[5];
-        filter[6].k = (uint32_t)addr0[0] << 8 | (uint32_t)addr0[1];
+        filter[8].k = (uint32_t)addr0[0] << 8 | (uint32_t)addr0[1];
 
-        filter[7].k = (uint32_t)addr1[2] << 24 | (uint32_t)addr1[3] << 16 |
+        filter[9].k = (uint32_t)addr1[2] << 24 | (uint32_t)addr1[3] << 16 |
                       (uint32_t)addr1[4] << 8 | (uint32_t)addr1[5];
-        filter[9].k = (uint32_t)addr1[0] << 8 | (uint32_t)addr1[1];
+        filter[11].k = (uint32_t)addr1[0] << 8 | (uint32_t)addr1[1];
 
         if (!addr0 && !addr1) {
             MAPF_WARN("at least one address should be specified for socket filter.");
@@ -58,20 +61,22 @@ public:
     const struct sock_fprog &sock_fprog() const { return fprog; }
 
 private:
-    struct sock_filter filter[17] = {
+    struct sock_filter filter[19] = {
         // This BPF is designed to accepts the following packets:
         // - IEEE1905 multicast packets (with IEEE1905 Multicast Address set as destination address)
         // - LLDP multicast packets (with LLDP Multicast Address as destination address)
         // - IEEE1905 unicast packets (with either this devices' AL MAC address or the interface's HW address set as destination address)
+        // Packets sent by this device (looped back to the socket as PACKET_OUTGOING) are dropped.
         //
-        // generated using: tcpdump -dd '(ether proto 0x893a and (ether dst 01:80:c2:00:00:13 or ether dst 11:22:33:44:55:66 or ether dst 77:88:99:aa:bb:cc)) or (ether proto 0x88cc and ether dst 01:80:c2:00:00:0e)'
+        // generated using: tcpdump -dd 'not outbound and ((ether proto 0x893a and (ether dst 01:80:c2:00:00:13 or ether dst 11:22:33:44:55:66 or ether dst 77:88:99:aa:bb:cc)) or (ether proto 0x88cc and ether dst 01:80:c2:00:00:0e))'
         // the two dummy addresses in this filter 11:22... and 77:88... will be replaced in runtime with the AL MAC address and the interface's HW address
         //
-        {0x28, 0, 0, 0x0000000c}, {0x15, 0, 8, 0x0000893a}, {0x20, 0, 0, 0x00000002},
-        {0x15, 9, 0, 0xc2000013}, {0x15, 0, 2, 0x33445566}, // 4: replace with AL MAC Addr [2..5]
-        {0x28, 0, 0, 0x00000000}, {0x15, 8, 9, 0x00001122}, // 6: replace with AL MAC Addr [0..1]
-        {0x15, 0, 8, 0x99aabbcc},                           // 7: replace with IF MAC Addr [2..5]
-        {0x28, 0, 0, 0x00000000}, {0x15, 5, 6, 0x00007788}, // 9: replace with IF MAC Addr [0..1]
+        {0x28, 0, 0, 0xfffff004}, {0x15, 16, 0, 0x00000004}, {0x28, 0, 0, 0x0000000c},
+        {0x15, 0, 8, 0x0000893a}, {0x20, 0, 0, 0x00000002}, {0x15, 9, 0, 0xc2000013},
+        {0x15, 0, 2, 0x33445566},                           // 6: replace with AL MAC Addr [2..5]
+        {0x28, 0, 0, 0x00000000}, {0x15, 8, 9, 0x00001122}, // 8: replace with AL MAC Addr [0..1]
+        {0x15, 0, 8, 0x99aabbcc},                           // 9: replace with IF MAC Addr [2..5]
+        {0x28, 0, 0, 0x00000000}, {0x15, 5, 6, 0x00007788}, // 11: replace with IF MAC Addr [0..1]
         {0x15, 0, 5, 0x000088cc}, {0x20, 0, 0, 0x00000002}, {0x15, 0, 3, 0xc200000e},
         {0x28, 0, 0, 0x00000000}, {0x15, 0, 1, 0x00000180}, {0x6, 0, 0, 0x0000ffff},
         {0x6, 0, 0, 0x00000000},
@@ -81,6 +86,223 @@ private:
                                .filter = filter};
 };
 
+// helper class to manage the extended BPF (eBPF) socket filter program - see bpf(2)
+// http://man7.org/linux/man-pages/man2/bpf.2.html
+//
+// The program accepts the same packets as Ieee1905SocketFilter and also counts the accepted
+// packets per message type in a BPF hash map, which is read by the transport. The map key is
+// (etherType << 16 | IEEE1905 messageType), the messageType of LLDP packets is 0.
+class Ieee1905EbpfSocketFilter {
+public:
+    struct Counters {
+        uint64_t packets;
+        uint64_t bytes;
+    };
+
+    // create a filter that counts the accepted packets in map_fd (see create_counters_map).
+    // The two addresses are the AL MAC address and the interface's hardware address
+    Ieee1905EbpfSocketFilter(int map_fd, const uint8_t *addr0 = NULL, const uint8_t *addr1 = NULL)
+    {
+        static const uint8_t ieee1905_multicast_address[ETH_ALEN] = {
+            0x01, 0x80, 0xc2, 0x00, 0x00, 0x13}; // 01:80:c2:00:00:13
+        static const uint8_t lldp_multicast_address[ETH_ALEN] = {
+            0x01, 0x80, 0xc2, 0x00, 0x00, 0x0e}; // 01:80:c2:00:00:0e
+
+        // r6 = struct __sk_buff (required by the BPF_ABS loads, which clobber r0-r5)
+        emit(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0);
+
+        // drop the packets sent by this device (looped back to the socket as PACKET_OUTGOING)
+        emit(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_0, BPF_REG_6, offsetof(struct __sk_buff, pkt_type),
+             0);
+        jump(BPF_JEQ | BPF_K, BPF_REG_0, 0, PACKET_OUTGOING, DROP);
+
+        emit(BPF_LD | BPF_H | BPF_ABS, 0, 0, 0, offsetof(struct ether_header, ether_type));
+        jump(BPF_JEQ | BPF_K, BPF_REG_0, 0, ETH_P_LLDP, LLDP);
+        jump(BPF_JNE | BPF_K, BPF_REG_0, 0, ETH_P_1905_1, DROP);
+
+        // IEEE1905 packets sent to the IEEE1905 Multicast Address or one of the two addresses
+        load_dst();
+        match_dst(ieee1905_multicast_address, IEEE1905_KEY);
+        match_dst(addr0 ? addr0 : ieee1905_multicast_address, IEEE1905_KEY);
+        match_dst(addr1 ? addr1 : ieee1905_multicast_address, IEEE1905_KEY);
+        jump(BPF_JA, 0, 0, 0, DROP);
+        label(IEEE1905_KEY);
+        emit(BPF_LD | BPF_H | BPF_ABS, 0, 0, 0, sizeof(struct ether_header) + 2); // messageType
+        emit(BPF_ALU | BPF_OR | BPF_K, BPF_REG_0, 0, 0, ETH_P_1905_1 << 16);
+        jump(BPF_JA, 0, 0, 0, COUNT);
+
+        // LLDP packets sent to the LLDP Multicast Address
+        label(LLDP);
+        load_dst();
+        match_dst(lldp_multicast_address, LLDP_KEY);
+        jump(BPF_JA, 0, 0, 0, DROP);
+        label(LLDP_KEY);
+        emit(BPF_ALU | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, ETH_P_LLDP << 16);
+
+        // add the packet to the counters of the key in r0, a missing key is inserted with the
+        // initial counters (both are passed on the stack)
+        label(COUNT);
+        emit(BPF_STX | BPF_MEM | BPF_W, BPF_REG_10, BPF_REG_0, kStackKey, 0);
+        load_map_fd(BPF_REG_1, map_fd);
+        emit(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_10, 0, 0);
+        emit(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_2, 0, 0, kStackKey);
+        emit(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_lookup_elem);
+        jump(BPF_JEQ | BPF_K, BPF_REG_0, 0, 0, INSERT);
+        emit(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_1, 0, 0, 1);
+        emit(BPF_STX | BPF_XADD | BPF_DW, BPF_REG_0, BPF_REG_1, offsetof(Counters, packets), 0);
+        emit(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_1, BPF_REG_6, offsetof(struct __sk_buff, len), 0);
+        emit(BPF_STX | BPF_XADD | BPF_DW, BPF_REG_0, BPF_REG_1, offsetof(Counters, bytes), 0);
+        jump(BPF_JA, 0, 0, 0, ACCEPT);
+
+        label(INSERT);
+        emit(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_1, 0, 0, 1);
+        emit(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_10, BPF_REG_1,
+             kStackCounters + (int)offsetof(Counters, packets), 0);
+        emit(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_1, BPF_REG_6, offsetof(struct __sk_buff, len), 0);
+        emit(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_10, BPF_REG_1,
+             kStackCounters + (int)offsetof(Counters, bytes), 0);
+        load_map_fd(BPF_REG_1, map_fd);
+        emit(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_10, 0, 0);
+        emit(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_2, 0, 0, kStackKey);
+        emit(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_3, BPF_REG_10, 0, 0);
+        emit(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_3, 0, 0, kStackCounters);
+        emit(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_4, 0, 0, BPF_ANY);
+        emit(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_update_elem);
+
+        label(ACCEPT);
+        emit(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, 0x0000ffff);
+        emit(BPF_JMP | BPF_EXIT, 0, 0, 0, 0);
+
+        label(DROP);
+        emit(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, 0);
+        emit(BPF_JMP | BPF_EXIT, 0, 0, 0, 0);
+
+        // all the labels are placed - set the jump offsets (relative to the next instruction)
+        for (const auto &jump : jumps) {
+            prog[jump.first].off = labels[jump.second] - jump.first - 1;
+        }
+    }
+
+    // load the program, return its file descriptor (to be attached with SO_ATTACH_BPF) or -1
+    int load() const
+    {
+        static const char license[] = "BSD";
+
+        union bpf_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.prog_type = BPF_PROG_TYPE_SOCKET_FILTER;
+        attr.insns     = (uint64_t)(uintptr_t)prog.data();
+        attr.insn_cnt  = prog.size();
+        attr.license   = (uint64_t)(uintptr_t)license;
+        return sys_bpf(BPF_PROG_LOAD, &attr);
+    }
+
+    // create the counters map, return its file descriptor or -1
+    static int create_counters_map()
+    {
+        union bpf_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.map_type    = BPF_MAP_TYPE_HASH;
+        attr.key_size    = sizeof(uint32_t);
+        attr.value_size  = sizeof(Counters);
+        attr.max_entries = kMaxCountedTypes;
+        return sys_bpf(BPF_MAP_CREATE, &attr);
+    }
+
+    // read the counters of all the message types received so far
+    static bool read_counters(int map_fd, std::map<uint32_t, Counters> &counters)
+    {
+        // 0 is never used as a key, so the iteration starts with the first key
+        uint32_t key = 0;
+        uint32_t next_key;
+        Counters value;
+        union bpf_attr attr;
+        while (true) {
+            memset(&attr, 0, sizeof(attr));
+            attr.map_fd   = map_fd;
+            attr.key      = (uint64_t)(uintptr_t)&key;
+            attr.next_key = (uint64_t)(uintptr_t)&next_key;
+            if (sys_bpf(BPF_MAP_GET_NEXT_KEY, &attr) < 0) {
+                return errno == ENOENT;
+            }
+
+            memset(&attr, 0, sizeof(attr));
+            attr.map_fd = map_fd;
+            attr.key    = (uint64_t)(uintptr_t)&next_key;
+            attr.value  = (uint64_t)(uintptr_t)&value;
+            if (sys_bpf(BPF_MAP_LOOKUP_ELEM, &attr) == 0) {
+                counters[next_key] = value;
+            }
+            key = next_key;
+        }
+    }
+
+private:
+    static const uint32_t kMaxCountedTypes = 256;
+
+    // stack (frame pointer) offsets of the map key and of the initial counters
+    static const int kStackKey      = -4;
+    static const int kStackCounters = -24;
+
+    enum Label { DROP, ACCEPT, LLDP, IEEE1905_KEY, LLDP_KEY, COUNT, INSERT, NUM_LABELS };
+
+    std::vector<struct bpf_insn> prog;
+    size_t labels[NUM_LABELS] = {0};
+    std::vector<std::pair<size_t, Label>> jumps; // instruction index and target label
+
+    static int sys_bpf(enum bpf_cmd cmd, union bpf_attr *attr)
+    {
+        return syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+    }
+
+    void emit(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm)
+    {
+        struct bpf_insn insn;
+        memset(&insn, 0, sizeof(insn));
+        insn.code    = code;
+        insn.dst_reg = dst;
+        insn.src_reg = src;
+        insn.off     = off;
+        insn.imm     = imm;
+        prog.push_back(insn);
+    }
+
+    void jump(uint8_t op, uint8_t dst, uint8_t src, int32_t imm, Label target)
+    {
+        jumps.push_back(std::make_pair(prog.size(), target));
+        emit(BPF_JMP | op, dst, src, 0, imm);
+    }
+
+    void label(Label label) { labels[label] = prog.size(); }
+
+    // load a map file descriptor (a double-word immediate, which takes two instructions)
+    void load_map_fd(uint8_t dst, int map_fd)
+    {
+        emit(BPF_LD | BPF_DW | BPF_IMM, dst, BPF_PSEUDO_MAP_FD, 0, map_fd);
+        emit(0, 0, 0, 0, 0);
+    }
+
+    // r0 = destination address [0..1], r7 = destination address [2..5]
+    void load_dst()
+    {
+        emit(BPF_LD | BPF_W | BPF_ABS, 0, 0, 0, 2);
+        emit(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_7, BPF_REG_0, 0, 0);
+        emit(BPF_LD | BPF_H | BPF_ABS, 0, 0, 0, 0);
+    }
+
+    // jump to target if the destination address (see load_dst) is addr
+    void match_dst(const uint8_t *addr, Label target)
+    {
+        // 32 bit immediates are sign extended by 64 bit compares, so the low part is moved into
+        // a register (zero extended) first
+        emit(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_0, 0, 2, (uint32_t)addr[0] << 8 | addr[1]);
+        emit(BPF_ALU | BPF_MOV | BPF_K, BPF_REG_1, 0, 0,
+             (uint32_t)addr[2] << 24 | (uint32_t)addr[3] << 16 | (uint32_t)addr[4] << 8 |
+                 (uint32_t)addr[5]);
+        jump(BPF_JEQ | BPF_X, BPF_REG_7, BPF_REG_1, 0, target);
+    }
+};
+
 void Ieee1905Transport::update_network_interfaces(
     std::map<unsigned int, NetworkInterface> updated_network_interfaces)
 {
@@ -93,7 +315,7 @@ void Ieee1905Transport::update_network_interfaces(
             MAPF_DBG("interface " << if_index << " is no longer used.");
             if (network_interface.fd >= 0) {
                 poller_.Remove(network_interface.fd);
-                close(network_interface.fd);
+                close_interface_socket(if_index);
             }
 
             it = network_interfaces_.erase(it);
@@ -112,6 +334,15 @@ void Ieee1905Transport::update_network_interfaces(
         network_interfaces_[if_index].bridge_if_index = updated_network_interface.bridge_if_index;
         network_interfaces_[if_index].is_bridge       = updated_network_interface.is_bridge;
 
+        // the RX ring is set up when the socket is opened - reopen it if the mode was changed
+        if (network_interfaces_[if_index].use_rx_ring != updated_network_interface.use_rx_ring) {
+            network_interfaces_[if_index].use_rx_ring = updated_network_interface.use_rx_ring;
+            if (network_interfaces_[if_index].fd >= 0) {
+                poller_.Remove(network_interfaces_[if_index].fd);
+                close_interface_socket(if_index);
+            }
+        }
+
         // must be called before open_interface_socket (address is used for packet filtering)
         if (!get_interface_mac_addr(if_index, network_interfaces_[if_index].addr)) {
             MAPF_WARN("cannot get address of interface " << if_index << ".");
@@ -142,8 +373,7 @@ bool Ieee1905Transport::open_interface_socket(unsigned int if_index)
     MAPF_DBG("opening raw socket on interface " << if_index << ".");
 
     if (network_interfaces_[if_index].fd != -1) {
-        close(network_interfaces_[if_index].fd);
-        network_interfaces_[if_index].fd = -1;
+        close_interface_socket(if_index);
     }
 
     // Note to developer: The current implementation uses AF_PACKET socket with SOCK_RAW protocol which means we receive
@@ -166,6 +396,13 @@ bool Ieee1905Transport::open_interface_socket(unsigned int if_index)
         return false;
     }
 
+    // bridge interfaces are not read, so they don't need a ring
+    // if the ring cannot be set up the socket is read with recvmmsg instead
+    if (network_interfaces_[if_index].use_rx_ring && !network_interfaces_[if_index].is_bridge &&
+        !setup_interface_rx_ring(sockfd, network_interfaces_[if_index])) {
+        MAPF_WARN("cannot set up RX ring on interface " << if_index << ", using recvmmsg.");
+    }
+
     // bind to specifed interface - note that we cannot use SO_BINDTODEVICE sockopt as it does not support AF_PACKET sockets
     struct sockaddr_ll sockaddr;
     memset(&sockaddr, 0, sizeof(struct sockaddr_ll));
@@ -175,7 +412,8 @@ bool Ieee1905Transport::open_interface_socket(unsigned int if_index)
     if (bind(sockfd, (struct sockaddr *)&sockaddr, sizeof(sockaddr)) < 0) {
         MAPF_ERR("cannot bind socket to interface \"" << strerror(errno) << "\" (" << errno
                                                       << ").");
-        close(sockfd);
+        network_interfaces_[if_index].fd = sockfd;
+        close_interface_socket(if_index);
         return false;
     }
 
@@ -186,6 +424,68 @@ bool Ieee1905Transport::open_interface_socket(unsigned int if_index)
     return true;
 }
 
+bool Ieee1905Transport::setup_interface_rx_ring(int sockfd, NetworkInterface &network_interface)
+{
+    // see https://www.kernel.org/doc/Documentation/networking/packet_mmap.txt
+    static_assert(kRxRingFrameSize >= TPACKET_ALIGN(TPACKET3_HDRLEN) + ETH_FRAME_LEN,
+                  "RX ring frames must hold a full ethernet frame");
+    static_assert(kRxRingBlockSize % kRxRingFrameSize == 0,
+                  "RX ring blocks must hold a whole number of frames");
+
+    int version = TPACKET_V3;
+    if (setsockopt(sockfd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+        MAPF_ERR("cannot set socket option PACKET_VERSION \"" << strerror(errno) << "\" (" << errno
+                                                             << ").");
+        return false;
+    }
+
+    struct tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size       = kRxRingBlockSize;
+    req.tp_block_nr         = kRxRingBlockCount;
+    req.tp_frame_size       = kRxRingFrameSize;
+    req.tp_frame_nr         = kRxRingBlockCount * (kRxRingBlockSize / kRxRingFrameSize);
+    req.tp_retire_blk_tov   = kRxRingBlockTimeoutMs;
+    req.tp_feature_req_word = 0;
+    if (setsockopt(sockfd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+        MAPF_ERR("cannot set socket option PACKET_RX_RING \"" << strerror(errno) << "\" (" << errno
+                                                             << ").");
+        return false;
+    }
+
+    void *ring = mmap(NULL, kRxRingBlockSize * kRxRingBlockCount, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, sockfd, 0);
+    if (ring == MAP_FAILED) {
+        MAPF_ERR("cannot map RX ring \"" << strerror(errno) << "\" (" << errno << ").");
+        // the ring is released when the socket is closed
+        return false;
+    }
+
+    network_interface.rx_ring       = (uint8_t *)ring;
+    network_interface.rx_ring_block = 0;
+
+    return true;
+}
+
+void Ieee1905Transport::close_interface_socket(unsigned int if_index)
+{
+    auto &network_interface = network_interfaces_[if_index];
+
+    if (network_interface.filter_counters_fd >= 0) {
+        log_interface_filter_counters(if_index);
+        close(network_interface.filter_counters_fd);
+        network_interface.filter_counters_fd = -1;
+    }
+
+    if (network_interface.rx_ring) {
+        munmap(network_interface.rx_ring, kRxRingBlockSize * kRxRingBlockCount);
+        network_interface.rx_ring = nullptr;
+    }
+
+    close(network_interface.fd);
+    network_interface.fd = -1;
+}
+
 bool Ieee1905Transport::attach_interface_socket_filter(unsigned int if_index)
 {
     if (!network_interfaces_.count(if_index)) {
@@ -207,9 +507,14 @@ bool Ieee1905Transport::attach_interface_socket_filter(unsigned int if_index)
         return false;
     }
 
+    // prefer the eBPF filter (which also maintains the per message type counters)
+    if (attach_interface_ebpf_socket_filter(if_index)) {
+        return true;
+    }
+
     // prepare linux packet filter for this interface
-    struct sock_fprog fprog =
-        Ieee1905SocketFilter(al_mac_addr_, network_interfaces_[if_index].addr).sock_fprog();
+    Ieee1905SocketFilter filter(al_mac_addr_, network_interfaces_[if_index].addr);
+    struct sock_fprog fprog = filter.sock_fprog();
 
     // attach filter
     if (setsockopt(network_interfaces_[if_index].fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog,
@@ -221,6 +526,63 @@ bool Ieee1905Transport::attach_interface_socket_filter(unsigned int if_index)
     return true;
 }
 
+bool Ieee1905Transport::attach_interface_ebpf_socket_filter(unsigned int if_index)
+{
+    auto &network_interface = network_interfaces_[if_index];
+
+    // the counters map is kept when the filter is replaced (e.g. when the AL MAC address is set)
+    if (network_interface.filter_counters_fd < 0) {
+        network_interface.filter_counters_fd = Ieee1905EbpfSocketFilter::create_counters_map();
+        if (network_interface.filter_counters_fd < 0) {
+            MAPF_DBG("cannot create eBPF map \"" << strerror(errno) << "\" (" << errno
+                                                << "), using classic BPF.");
+            return false;
+        }
+    }
+
+    int prog_fd = Ieee1905EbpfSocketFilter(network_interface.filter_counters_fd, al_mac_addr_,
+                                           network_interface.addr)
+                      .load();
+    if (prog_fd < 0) {
+        MAPF_DBG("cannot load eBPF program \"" << strerror(errno) << "\" (" << errno
+                                              << "), using classic BPF.");
+        close(network_interface.filter_counters_fd);
+        network_interface.filter_counters_fd = -1;
+        return false;
+    }
+
+    // the socket holds a reference to the program
+    int ret =
+        setsockopt(network_interface.fd, SOL_SOCKET, SO_ATTACH_BPF, &prog_fd, sizeof(prog_fd));
+    close(prog_fd);
+    if (ret == -1) {
+        MAPF_DBG("cannot attach eBPF socket filter \"" << strerror(errno) << "\" (" << errno
+                                                      << "), using classic BPF.");
+        close(network_interface.filter_counters_fd);
+        network_interface.filter_counters_fd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void Ieee1905Transport::log_interface_filter_counters(unsigned int if_index)
+{
+    std::map<uint32_t, Ieee1905EbpfSocketFilter::Counters> counters;
+    if (!Ieee1905EbpfSocketFilter::read_counters(network_interfaces_[if_index].filter_counters_fd,
+                                                 counters)) {
+        MAPF_ERR("cannot read the socket filter counters of interface " << if_index << ".");
+        return;
+    }
+
+    for (const auto &entry : counters) {
+        MAPF_DBG("interface " << if_index << " etherType 0x" << std::hex << (entry.first >> 16)
+                              << " messageType 0x" << (entry.first & 0xFFFF) << std::dec << ": "
+                              << entry.second.packets << " packets, " << entry.second.bytes
+                              << " bytes.");
+    }
+}
+
 void Ieee1905Transport::handle_interface_status_change(unsigned int if_index, bool is_active)
 {
     if (!network_interfaces_.count(if_index)) {
@@ -232,8 +594,7 @@ void Ieee1905Transport::handle_interface_status_change(unsigned int if_index, bo
 
     if (!is_active && network_interfaces_[if_index].fd >= 0) {
         poller_.Remove(network_interfaces_[if_index].fd);
-        close(network_interfaces_[if_index].fd);
-        network_interfaces_[if_index].fd = -1;
+        close_interface_socket(if_index);
     }
 
     if (is_active && network_interfaces_[if_index].fd < 0) {
@@ -254,25 +615,86 @@ void Ieee1905Transport::handle_interface_pollin_event(int fd)
 
     // Note to developer: add support for VLAN ethernet header (if required)?
 
-    uint8_t buf[ETH_FRAME_LEN];
-    struct sockaddr_ll addr;
-    socklen_t addr_len = sizeof(addr);
-    ssize_t len = recvfrom(fd, buf, sizeof(buf), MSG_DONTWAIT | MSG_TRUNC, (struct sockaddr *)&addr,
-                           &addr_len);
-    if (len == -1 && (errno == EWOULDBLOCK || errno == EAGAIN)) {
-        return;
+    uint8_t bufs[kNetworkRxBatchSize][ETH_FRAME_LEN];
+    struct sockaddr_ll addrs[kNetworkRxBatchSize];
+    struct iovec iovs[kNetworkRxBatchSize];
+    struct mmsghdr msgs[kNetworkRxBatchSize];
+
+    // drain the socket - read all the queued packets (up to a limit) in batches
+    for (int batch = 0; batch < kMaximumNetworkRxBatchesPerEvent; batch++) {
+        memset(msgs, 0, sizeof(msgs));
+        for (int i = 0; i < kNetworkRxBatchSize; i++) {
+            iovs[i].iov_base            = bufs[i];
+            iovs[i].iov_len             = sizeof(bufs[i]);
+            msgs[i].msg_hdr.msg_iov     = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen  = 1;
+            msgs[i].msg_hdr.msg_name    = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+        }
+
+        int n = recvmmsg(fd, msgs, kNetworkRxBatchSize, MSG_DONTWAIT | MSG_TRUNC, nullptr);
+        if (n == -1 && (errno == EWOULDBLOCK || errno == EAGAIN)) {
+            return;
+        }
+        if (n == -1) {
+            MAPF_ERR("cannot read from socket \"" << strerror(errno) << "\" (" << errno << ").");
+            return;
+        }
+
+        counters_[CounterId::INCOMMING_NETWORK_BATCHES]++;
+        for (int i = 0; i < n; i++) {
+            handle_interface_packet(bufs[i], msgs[i].msg_len, addrs[i]);
+        }
+
+        if (n < kNetworkRxBatchSize) {
+            // the socket is empty
+            return;
+        }
     }
-    if (len == -1) {
-        MAPF_ERR("cannot read from socket \"" << strerror(errno) << "\" (" << errno << ").");
-        return;
+}
+
+void Ieee1905Transport::handle_interface_rx_ring_event(NetworkInterface &network_interface)
+{
+    // handle all the blocks handed over by the kernel (at most a full ring) - the frames are
+    // handled in place and each block is returned to the kernel once all its frames were handled
+    for (unsigned int n = 0; n < kRxRingBlockCount; n++) {
+        auto block = (struct tpacket_block_desc *)(network_interface.rx_ring +
+                                                   network_interface.rx_ring_block *
+                                                       kRxRingBlockSize);
+        if (!(block->hdr.bh1.block_status & TP_STATUS_USER)) {
+            return;
+        }
+        // the block content is read only after its status
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        counters_[CounterId::INCOMMING_NETWORK_BATCHES]++;
+        auto hdr = (struct tpacket3_hdr *)((uint8_t *)block + block->hdr.bh1.offset_to_first_pkt);
+        for (uint32_t i = 0; i < block->hdr.bh1.num_pkts; i++) {
+            // frames are never truncated by the ring (see kRxRingFrameSize), tp_len is passed so
+            // that oversized packets are reported just like with recvmmsg (MSG_TRUNC)
+            auto addr =
+                (struct sockaddr_ll *)((uint8_t *)hdr + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+            handle_interface_packet((uint8_t *)hdr + hdr->tp_mac, hdr->tp_len, *addr);
+            hdr = (struct tpacket3_hdr *)((uint8_t *)hdr + hdr->tp_next_offset);
+        }
+
+        // all the frames of the block were handled - return it to the kernel
+        std::atomic_thread_fence(std::memory_order_release);
+        block->hdr.bh1.block_status     = TP_STATUS_KERNEL;
+        network_interface.rx_ring_block = (network_interface.rx_ring_block + 1) % kRxRingBlockCount;
     }
-    if (len < (ssize_t)sizeof(struct ether_header)) {
+}
+
+void Ieee1905Transport::handle_interface_packet(uint8_t *buf, size_t len,
+                                                const struct sockaddr_ll &addr)
+{
+    if (len < sizeof(struct ether_header)) {
         MAPF_WARN("received packet smaller than ethernet header size (dropped).");
         return;
     }
-    if (len > int(sizeof(buf))) {
+    if (len > ETH_FRAME_LEN) {
         MAPF_WARN("received oversized packet (truncated).");
-        len = sizeof(buf);
+        len = ETH_FRAME_LEN;
     }
 
     MAPF_DBG("received packet on interface " << addr.sll_ifindex << ".");
@@ -332,9 +754,11 @@ bool Ieee1905Transport::get_interface_mac_addr(unsigned int if_index, uint8_t *a
     return true;
 }
 
+// The packet is only queued here and sent by flush_network_tx_queue(), so a true return value
+// means "queued" - frames which then fail to send are logged and counted as dropped by the flush.
 bool Ieee1905Transport::send_packet_to_network_interface(unsigned int if_index, Packet &packet)
 {
-    MAPF_DBG("sending packet on interface " << if_index << ".");
+    MAPF_DBG("queueing packet for interface " << if_index << ".");
 
     if (!network_interfaces_.count(if_index)) {
         MAPF_ERR("un-tracked interface " << if_index << ".");
@@ -348,20 +772,75 @@ bool Ieee1905Transport::send_packet_to_network_interface(unsigned int if_index,
     std::copy_n(packet.src, ETH_ALEN, eh.ether_shost);
     eh.ether_type = htons(packet.ether_type);
 
-    packet.header = {.iov_base = &eh, .iov_len = sizeof(eh)};
+    // copy the frame - the packet payload (e.g. a fragment buffer) may be reused before the
+    // queue is flushed
+    NetworkTxFrame frame;
+    frame.if_index = if_index;
+    frame.offset   = network_tx_data_.size();
+    frame.len      = sizeof(eh) + packet.payload.iov_len;
+    network_tx_data_.insert(network_tx_data_.end(), (uint8_t *)&eh, (uint8_t *)&eh + sizeof(eh));
+    network_tx_data_.insert(network_tx_data_.end(), (uint8_t *)packet.payload.iov_base,
+                            (uint8_t *)packet.payload.iov_base + packet.payload.iov_len);
+    network_tx_queue_.push_back(frame);
+
+    return true;
+}
 
-    int fd             = network_interfaces_[if_index].fd;
-    struct iovec iov[] = {packet.header, packet.payload};
-    int n              = writev(fd, iov, sizeof(iov) / sizeof(struct iovec));
+void Ieee1905Transport::flush_network_tx_queue()
+{
+    // frames are queued interface by interface (all the fragments of a packet on one interface,
+    // then on the next one) - send each run of frames of the same interface in batches
+    size_t first = 0;
+    while (first < network_tx_queue_.size()) {
+        unsigned int if_index = network_tx_queue_[first].if_index;
+        size_t last           = first + 1;
+        while (last < network_tx_queue_.size() && last - first < kNetworkTxBatchSize &&
+               network_tx_queue_[last].if_index == if_index) {
+            last++;
+        }
+        send_network_tx_frames(if_index, &network_tx_queue_[first], last - first);
+        first = last;
+    }
 
-    // Clear the packet header to prevent leaking locally allocated stack pointer
-    packet.header = {.iov_base = nullptr, .iov_len = sizeof(eh)};
-    if (size_t(n) != sizeof(eh) + packet.payload.iov_len) {
-        MAPF_ERR("cannot write to socket \"" << strerror(errno) << "\" (" << errno << ").");
-        return false;
+    network_tx_queue_.clear();
+    network_tx_data_.clear();
+}
+
+void Ieee1905Transport::send_network_tx_frames(unsigned int if_index, const NetworkTxFrame *frames,
+                                               int count)
+{
+    MAPF_DBG("sending " << count << " packet(s) on interface " << if_index << ".");
+
+    int fd = network_interfaces_.count(if_index) ? network_interfaces_[if_index].fd : -1;
+    if (fd < 0) {
+        MAPF_ERR("interface " << if_index << " is gone, dropping " << count << " frame(s).");
+        counters_[CounterId::OUTGOING_NETWORK_DROPPED_FRAMES] += count;
+        return;
     }
 
-    return true;
+    struct iovec iovs[kNetworkTxBatchSize];
+    struct mmsghdr msgs[kNetworkTxBatchSize];
+    memset(msgs, 0, sizeof(msgs));
+    for (int i = 0; i < count; i++) {
+        iovs[i].iov_base           = network_tx_data_.data() + frames[i].offset;
+        iovs[i].iov_len            = frames[i].len;
+        msgs[i].msg_hdr.msg_iov    = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int sent = 0;
+    while (sent < count) {
+        int n = sendmmsg(fd, msgs + sent, count - sent, 0);
+        counters_[CounterId::OUTGOING_NETWORK_BATCHES]++;
+        if (n <= 0) {
+            MAPF_ERR("cannot write to socket \"" << strerror(errno) << "\" (" << errno
+                                                 << "), dropping " << count - sent
+                                                 << " frame(s) on interface " << if_index << ".");
+            counters_[CounterId::OUTGOING_NETWORK_DROPPED_FRAMES] += count - sent;
+            return;
+        }
+        sent += n;
+    }
 }
 
 void Ieee1905Transport::set_al_mac_addr(const uint8_t *addr)
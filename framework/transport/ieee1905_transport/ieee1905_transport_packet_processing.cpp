@@ -38,6 +38,9 @@ void Ieee1905Transport::handle_packet(Packet &packet)
     if (!forward_packet(packet)) {
         MAPF_WARN("packet forwarding failed.");
     }
+
+    // send all the frames queued while forwarding the packet
+    flush_network_tx_queue();
 }
 
 // do some basic sanity checking on the packet
@@ -107,16 +110,8 @@ bool Ieee1905Transport::de_duplicate_packet(Packet &packet)
 
     std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
 
-    // de-duplication map aging - go over all entries and remove old ones
-    for (auto it = de_duplication_map_.begin(); it != de_duplication_map_.end();) {
-        auto &dupval = it->second;
-
-        if (now > dupval.time + kMaximumDeDuplicationAge) {
-            it = de_duplication_map_.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // de-duplication table aging - remove old entries (only the oldest entries are visited)
+    de_duplication_table_.expire(now);
 
     // search for entry matching packet
     DeDuplicationKey key;
@@ -125,24 +120,17 @@ bool Ieee1905Transport::de_duplicate_packet(Packet &packet)
     key.messageId   = ((Ieee1905CmduHeader *)packet.payload.iov_base)->messageId;
     key.fragmentId  = ((Ieee1905CmduHeader *)packet.payload.iov_base)->fragmentId;
 
-    auto it           = de_duplication_map_.find(key);
-    bool is_duplicate = (it != de_duplication_map_.end());
+    auto val          = de_duplication_table_.find(key, now);
+    bool is_duplicate = (val != nullptr);
 
     if (is_duplicate) {
         // this is a duplicate packet - update timestamp
         counters_[CounterId::DUPLICATE_PACKETS]++;
-        auto &val = it->second;
-        val.time  = now;
-    } else if (int(de_duplication_map_.size()) >= kMaximumDeDuplicationThreads) {
+        val->time = now;
+    } else if (!de_duplication_table_.insert(key, now)) {
         // this is not really a duplicate but we cannot track it so it will be dropped now
         MAPF_WARN("too many de-duplication threads - dropping packet as duplicate");
         is_duplicate = true;
-    } else {
-        // this is not a duplicate packet - add new entry to the de-duplication map
-        DeDuplicationValue val;
-
-        val.time                 = now;
-        de_duplication_map_[key] = val;
     }
 
     return !is_duplicate;
@@ -172,54 +160,51 @@ bool Ieee1905Transport::de_fragment_packet(Packet &packet)
 
     std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
 
-    // de-fragmentation map cleanup - go over all entries and remove old ones or complete ones
-    for (auto it = de_fragmentation_map_.begin(); it != de_fragmentation_map_.end();) {
-        auto &val = it->second;
-
-        if (val.complete) {
-            it = de_fragmentation_map_.erase(it);
-        } else if (now > val.time + kMaximumDeFragmentationAge) {
-            // Note: this is not necessarily related to the current fragment referenced by the argument to this method
-            MAPF_DBG("defragmentation timeout - dropping a packet from defragmentation buffer");
-            it = de_fragmentation_map_.erase(it);
-            counters_[CounterId::DEFRAGMENTATION_FAILURE]++;
-        } else {
-            ++it;
-        }
-    }
+    // the previously de-fragmented packet is no longer in use - recycle its buffer
+    release_de_fragmentation_buffer(de_fragmented_buf_);
+
+    // de-fragmentation table cleanup - remove old entries (only the oldest entries are visited)
+    auto on_timeout = [&](DeFragmentationValue &val) {
+        // Note: this is not necessarily related to the current fragment referenced by the argument to this method
+        MAPF_DBG("defragmentation timeout - dropping a packet from defragmentation buffer");
+        counters_[CounterId::DEFRAGMENTATION_FAILURE]++;
+        release_de_fragmentation_buffer(val.buf);
+    };
+    de_fragmentation_table_.expire(now, on_timeout);
 
-    // build the key to the de-fragmentation map
+    // build the key to the de-fragmentation table
     DeFragmentationKey key;
     std::copy_n(packet.src, ETH_ALEN, key.src);
     key.messageType = ch->messageType;
     key.messageId   = ch->messageId;
 
-    auto &val = de_fragmentation_map_[key]; // find a match (or create a new entry)
-
-    // limit the map size (to prevent a possible memory exhaustion attack)
-    // Note: at this stage there could be one extra entry in the map (this is still effective and the code is simple)
-    if (int(de_fragmentation_map_.size()) > kMaximumDeFragmentationThreads) {
-        de_fragmentation_map_.erase(key);
-        MAPF_WARN("too many de-fragmentation threads - dropping packet");
-        return false;
+    // find a match (or create a new entry)
+    auto val = de_fragmentation_table_.find(key, now);
+    if (!val) {
+        // limit the table size (to prevent a possible memory exhaustion attack)
+        val = de_fragmentation_table_.insert(key, now, on_timeout);
+        if (!val) {
+            MAPF_WARN("too many de-fragmentation threads - dropping packet");
+            return false;
+        }
+        val->buf = get_de_fragmentation_buffer();
     }
 
-    val.time = now;
+    val->time = now;
 
     // only accept fragments in order - check if this is the expected fragment
-    if (val.numFragments != ch->fragmentId) {
+    if (val->numFragments != ch->fragmentId) {
         MAPF_DBG("dropping an out-of-order fragment");
         return false;
     }
 
     // copy the IEEE1905 header from the first fragment
     if (ch->fragmentId == 0) {
-        std::copy_n((uint8_t *)packet.payload.iov_base, sizeof(Ieee1905CmduHeader),
-                    (uint8_t *)val.buf);
-        val.bufIndex = sizeof(Ieee1905CmduHeader);
+        val->buf.assign((uint8_t *)packet.payload.iov_base,
+                        (uint8_t *)packet.payload.iov_base + sizeof(Ieee1905CmduHeader));
 
         // set the last fragment indicator flag as this will be the header of a complete CMDU
-        Ieee1905CmduHeader *hdr = reinterpret_cast<Ieee1905CmduHeader *>(val.buf);
+        Ieee1905CmduHeader *hdr = reinterpret_cast<Ieee1905CmduHeader *>(val->buf.data());
         hdr->SetLastFragmentIndicator(1);
     }
 
@@ -230,21 +215,23 @@ bool Ieee1905Transport::de_fragment_packet(Packet &packet)
         fragmentTlvsLength -= sizeof(Tlv);
     }
 
-    if (val.bufIndex + fragmentTlvsLength >= kMaximumDeFragmentionSize) {
+    if (val->buf.size() + fragmentTlvsLength >= kMaximumDeFragmentionSize) {
         MAPF_WARN("defragmentation buffer overflow - dropping fragment");
         return false;
     }
-    std::copy_n((uint8_t *)packet.payload.iov_base + sizeof(Ieee1905CmduHeader), fragmentTlvsLength,
-                val.buf + val.bufIndex);
-    val.bufIndex += fragmentTlvsLength;
-    val.numFragments++;
+    uint8_t *fragmentTlvs = (uint8_t *)packet.payload.iov_base + sizeof(Ieee1905CmduHeader);
+    val->buf.insert(val->buf.end(), fragmentTlvs, fragmentTlvs + fragmentTlvsLength);
+    val->numFragments++;
 
     // detect defragmentation completion and update Packet object
     if (ch->GetLastFragmentIndicator()) {
-        val.complete =
-            true; // mark as complete - the map entry will be deleted on the next invocation
-        packet.payload.iov_base = val.buf; // buffer is valid until next invocation of this method
-        packet.payload.iov_len  = val.bufIndex;
+        // keep the complete CMDU aside - the table entry is no longer needed
+        de_fragmented_buf_.swap(val->buf);
+        de_fragmentation_table_.erase(key);
+
+        // buffer is valid until next invocation of this method
+        packet.payload.iov_base = de_fragmented_buf_.data();
+        packet.payload.iov_len  = de_fragmented_buf_.size();
 
         return true;
     }
@@ -253,6 +240,31 @@ bool Ieee1905Transport::de_fragment_packet(Packet &packet)
     return false;
 }
 
+std::vector<uint8_t> Ieee1905Transport::get_de_fragmentation_buffer()
+{
+    if (de_fragmentation_buffer_pool_.empty()) {
+        return std::vector<uint8_t>();
+    }
+    std::vector<uint8_t> buf = std::move(de_fragmentation_buffer_pool_.back());
+    de_fragmentation_buffer_pool_.pop_back();
+    return buf;
+}
+
+void Ieee1905Transport::release_de_fragmentation_buffer(std::vector<uint8_t> &buf)
+{
+    if (buf.capacity() == 0) {
+        return;
+    }
+
+    // keep the buffer (and its capacity) for the next reassembly, unless it grew too large
+    if (buf.capacity() <= kMaximumPooledDeFragmentationBufferSize &&
+        de_fragmentation_buffer_pool_.size() < size_t(kMaximumDeFragmentationThreads)) {
+        buf.clear();
+        de_fragmentation_buffer_pool_.push_back(std::move(buf));
+    }
+    std::vector<uint8_t>().swap(buf);
+}
+
 // When an IEEE1905 packet (CMDU) is larger than a standard defined threshold (1500 bytes) it should be
 // fragmented into smaller than 1500 bytes fragments.
 //
@@ -9,14 +9,17 @@
 #ifndef MAP_TRANSPORT_IEEE1905_TRANSPORT_H_
 #define MAP_TRANSPORT_IEEE1905_TRANSPORT_H_
 
+#include "ieee1905_transport_aging_table.h"
 #include "ieee1905_transport_messages.h"
 #include <mapf/common/poller.h>
 #include <mapf/local_bus.h>
 
 #include <arpa/inet.h>
 #include <chrono>
+#include <linux/if_packet.h>
 #include <linux/netlink.h>
 #include <map>
+#include <vector>
 
 //
 // Notes:
@@ -63,6 +66,14 @@ private:
         unsigned int bridge_if_index =
             0;                  // the bridge's interface index (if this interface is in a bridge)
         bool is_bridge = false; // is this interface a bridge interface
+
+        // memory mapped RX ring (TPACKET_V3) - the socket is read with recvmmsg when not mapped
+        bool use_rx_ring           = false;   // requested with the ENABLE_RX_RING flag
+        uint8_t *rx_ring           = nullptr; // the mapped ring
+        unsigned int rx_ring_block = 0;       // the next block to be handed over by the kernel
+
+        // per message type counters of the eBPF socket filter (-1 if the classic filter is used)
+        int filter_counters_fd = -1;
     };
     std::map<unsigned int, NetworkInterface> network_interfaces_;
 
@@ -71,6 +82,7 @@ private:
 
     mapf::LocalBusInterface *local_bus_;
     mapf::Poller poller_;
+    std::unique_ptr<Message> local_bus_rx_msg_; // the last message received on the local bus
 
     uint16_t message_id_           = 0;
     uint8_t al_mac_addr_[ETH_ALEN] = {0};
@@ -119,6 +131,9 @@ private:
         OUTGOING_LOCAL_BUS_PACKETS,
         DUPLICATE_PACKETS,
         DEFRAGMENTATION_FAILURE,
+        INCOMMING_NETWORK_BATCHES,       // recvmmsg calls which returned packets / RX ring blocks
+        OUTGOING_NETWORK_BATCHES,        // sendmmsg calls
+        OUTGOING_NETWORK_DROPPED_FRAMES, // queued frames which failed to send
     };
     std::map<CounterId, unsigned long> counters_;
 
@@ -132,8 +147,10 @@ private:
         uint8_t dst[ETH_ALEN]     = {0}; // destination mac address
         uint8_t src[ETH_ALEN]     = {0}; // source mac address
         uint16_t ether_type       = 0x0000;
-        struct iovec header       = {.iov_base = NULL, .iov_len = 0};
-        struct iovec payload      = {.iov_base = NULL, .iov_len = 0};
+        // header and payload of a received packet may point into the RX ring of the interface
+        // and are only valid until handle_packet() returns
+        struct iovec header  = {.iov_base = NULL, .iov_len = 0};
+        struct iovec payload = {.iov_base = NULL, .iov_len = 0};
 
         virtual std::ostream &print(std::ostream &os) const;
     };
@@ -147,8 +164,8 @@ private:
     // should be short enough to handle the case when a device reboots (and reuses the same messageId).
     const std::chrono::milliseconds kMaximumDeDuplicationAge = std::chrono::milliseconds(1000);
 
-    // limit the size of the de-duplication map (to prevent memory exhaustion attack)
-    const int kMaximumDeDuplicationThreads = 1024;
+    // limit the size of the de-duplication table (to prevent memory exhaustion attack)
+    static const int kMaximumDeDuplicationThreads = 1024;
 
     struct DeDuplicationKey {
         uint8_t src[ETH_ALEN];
@@ -156,27 +173,28 @@ private:
             messageType; // required to distinguish the case of Request / Reply (when the reply carries an out of sync MID)
         uint16_t messageId;
         uint8_t fragmentId;
+        bool operator==(const DeDuplicationKey &other) const
+        {
+            return !memcmp(src, other.src, ETH_ALEN) && messageType == other.messageType &&
+                   messageId == other.messageId && fragmentId == other.fragmentId;
+        }
     };
-    struct DeDuplicationKeyCompare {
-        // implement Compare for the std::map template
-        bool operator()(const DeDuplicationKey &lhs, const DeDuplicationKey &rhs) const
+    struct DeDuplicationKeyHash {
+        // implement Hash for the AgingTable template
+        size_t operator()(const DeDuplicationKey &key) const
         {
-            // compare based on src address first then messageId, then fragmentId
-            int srccmp = memcmp(lhs.src, rhs.src, ETH_ALEN);
-            if (srccmp)
-                return srccmp < 0;
-            else if (lhs.messageType != rhs.messageType)
-                return lhs.messageType < rhs.messageType;
-            else if (lhs.messageId != rhs.messageId)
-                return lhs.messageId < rhs.messageId;
-            else
-                return lhs.fragmentId < rhs.fragmentId;
+            uint32_t hash = hash_mac(key.src);
+            hash          = hash_uint(hash, key.messageType);
+            hash          = hash_uint(hash, key.messageId);
+            return hash_uint(hash, key.fragmentId);
         }
     };
     struct DeDuplicationValue {
         std::chrono::steady_clock::time_point time;
     };
-    std::map<DeDuplicationKey, DeDuplicationValue, DeDuplicationKeyCompare> de_duplication_map_;
+    AgingTable<DeDuplicationKey, DeDuplicationValue, DeDuplicationKeyHash,
+               kMaximumDeDuplicationThreads>
+        de_duplication_table_{kMaximumDeDuplicationAge};
 
     // de-fragmentation internal data structures
 
@@ -186,40 +204,89 @@ private:
     // should be short enough to handle the case when a device reboots (and reuses the same messageId).
     const std::chrono::milliseconds kMaximumDeFragmentationAge = std::chrono::milliseconds(1000);
 
-    // limit the size of the de-fragmentation map (to prevent memory exhaustion attack)
-    const int kMaximumDeFragmentationThreads = 16;
+    // limit the size of the de-fragmentation table (to prevent memory exhaustion attack)
+    static const int kMaximumDeFragmentationThreads = 16;
 
     static const size_t kMaximumDeFragmentionSize = (64 * 1024);
 
+    // reassembly buffers larger than this are freed instead of being returned to the pool
+    static const size_t kMaximumPooledDeFragmentationBufferSize = (16 * 1024);
+
     struct DeFragmentationKey {
         uint8_t src[ETH_ALEN];
         uint16_t
             messageType; // required to distinguish the case of Request / Reply (when the reply carries an out of sync MID)
         uint16_t messageId;
+        bool operator==(const DeFragmentationKey &other) const
+        {
+            return !memcmp(src, other.src, ETH_ALEN) && messageType == other.messageType &&
+                   messageId == other.messageId;
+        }
     };
-    struct DeFragmentationKeyCompare {
-        // implement Compare for the std::map template
-        bool operator()(const DeFragmentationKey &lhs, const DeFragmentationKey &rhs) const
+    struct DeFragmentationKeyHash {
+        // implement Hash for the AgingTable template
+        size_t operator()(const DeFragmentationKey &key) const
         {
-            // compare based on src address first then messageId
-            int srccmp = memcmp(lhs.src, rhs.src, ETH_ALEN);
-            if (srccmp)
-                return srccmp < 0;
-            else if (lhs.messageType != rhs.messageType)
-                return lhs.messageType < rhs.messageType;
-            else
-                return lhs.messageId < rhs.messageId;
+            uint32_t hash = hash_mac(key.src);
+            hash          = hash_uint(hash, key.messageType);
+            return hash_uint(hash, key.messageId);
         }
     };
     struct DeFragmentationValue {
         std::chrono::steady_clock::time_point time;
-        uint8_t numFragments                   = 0;
-        uint8_t buf[kMaximumDeFragmentionSize] = {0};
-        int bufIndex                           = 0;
-        bool complete                          = false;
+        uint8_t numFragments = 0;
+        std::vector<uint8_t> buf; // grows with the received fragments (taken from the pool)
+    };
+    AgingTable<DeFragmentationKey, DeFragmentationValue, DeFragmentationKeyHash,
+               kMaximumDeFragmentationThreads>
+        de_fragmentation_table_{kMaximumDeFragmentationAge};
+
+    // reassembly buffers are recycled so that steady state de-fragmentation does not allocate
+    std::vector<std::vector<uint8_t>> de_fragmentation_buffer_pool_;
+    // the last reassembled CMDU - the de-fragmented packet points to it until the next
+    // invocation of de_fragment_packet()
+    std::vector<uint8_t> de_fragmented_buf_;
+
+    // FNV-1a hashing of the de-duplication and de-fragmentation keys
+    static uint32_t hash_uint(uint32_t hash, uint32_t value, size_t len = 2)
+    {
+        for (size_t i = 0; i < len; i++) {
+            hash = (hash ^ ((value >> (8 * i)) & 0xFF)) * 16777619;
+        }
+        return hash;
+    }
+    static uint32_t hash_mac(const uint8_t *mac)
+    {
+        uint32_t hash = 2166136261;
+        for (int i = 0; i < ETH_ALEN; i++) {
+            hash = (hash ^ mac[i]) * 16777619;
+        }
+        return hash;
+    }
+
+    // network interface sockets are read and written in batches (recvmmsg / sendmmsg)
+    static const int kNetworkRxBatchSize = 16;
+    // limit the number of batches read per poll event so that other sockets are not starved
+    static const int kMaximumNetworkRxBatchesPerEvent = 8;
+    static const int kNetworkTxBatchSize              = 32;
+
+    // TPACKET_V3 RX ring geometry (per interface). The kernel fills a block with the received
+    // frames and hands it over when it is full or kRxRingBlockTimeoutMs after its first frame.
+    static const unsigned int kRxRingBlockSize      = (64 * 1024);
+    static const unsigned int kRxRingBlockCount     = 8;
+    static const unsigned int kRxRingFrameSize      = 2048;
+    static const unsigned int kRxRingBlockTimeoutMs = 4;
+
+    // frames (ethernet header + payload) queued for transmission on the network interfaces.
+    // The frames of a handled packet (all fragments, on all interfaces) are queued and then
+    // sent with a single sendmmsg per interface.
+    struct NetworkTxFrame {
+        unsigned int if_index;
+        size_t offset; // offset of the frame in network_tx_data_
+        size_t len;
     };
-    std::map<DeFragmentationKey, DeFragmentationValue, DeFragmentationKeyCompare>
-        de_fragmentation_map_;
+    std::vector<NetworkTxFrame> network_tx_queue_;
+    std::vector<uint8_t> network_tx_data_;
 
     static const int kIeee1905FragmentationThreashold =
         1500 -
@@ -231,11 +298,19 @@ private:
     void
     update_network_interfaces(std::map<unsigned int, NetworkInterface> updated_network_interfaces);
     bool open_interface_socket(unsigned int if_index);
+    bool setup_interface_rx_ring(int sockfd, NetworkInterface &network_interface);
+    void close_interface_socket(unsigned int if_index);
     bool attach_interface_socket_filter(unsigned int if_index);
+    bool attach_interface_ebpf_socket_filter(unsigned int if_index);
+    void log_interface_filter_counters(unsigned int if_index);
     void handle_interface_status_change(unsigned int if_index, bool is_active);
     void handle_interface_pollin_event(int fd);
+    void handle_interface_rx_ring_event(NetworkInterface &network_interface);
+    void handle_interface_packet(uint8_t *buf, size_t len, const struct sockaddr_ll &addr);
     bool get_interface_mac_addr(unsigned int if_index, uint8_t *addr);
     bool send_packet_to_network_interface(unsigned int if_index, Packet &packet);
+    void flush_network_tx_queue();
+    void send_network_tx_frames(unsigned int if_index, const NetworkTxFrame *frames, int count);
     void set_al_mac_addr(const uint8_t *addr);
 
     //
@@ -263,6 +338,8 @@ private:
     bool verify_packet(Packet &packet);
     bool de_duplicate_packet(Packet &packet);
     bool de_fragment_packet(Packet &packet);
+    std::vector<uint8_t> get_de_fragmentation_buffer();
+    void release_de_fragmentation_buffer(std::vector<uint8_t> &buf);
     bool fragment_and_send_packet_to_network_interface(unsigned int if_index, Packet &packet);
     bool forward_packet(Packet &packet);
 };
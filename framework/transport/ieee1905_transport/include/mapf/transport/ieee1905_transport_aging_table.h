@@ -0,0 +1,264 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef MAP_TRANSPORT_IEEE1905_TRANSPORT_AGING_TABLE_H_
+#define MAP_TRANSPORT_IEEE1905_TRANSPORT_AGING_TABLE_H_
+
+#include <array>
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+namespace mapf {
+
+constexpr size_t aging_table_next_pow2(size_t n, size_t p = 1)
+{
+    return (p >= n) ? p : aging_table_next_pow2(n, p << 1);
+}
+
+//
+// Fixed capacity hash table with time based aging, used by the de-duplication and
+// de-fragmentation logic of the transport.
+//
+// The table uses open addressing (linear probing with backward shift deletion) over a
+// statically sized slot array, so lookups and insertions never allocate memory.
+//
+// Aging is done through an expiry ring that holds the entries in insertion order. Since all
+// entries share the same maximum age only the oldest ones need to be checked, which makes
+// aging amortized O(1) instead of a scan over the whole table. An entry whose time was
+// refreshed after insertion is moved to the back of the ring when it reaches the front, so it
+// may be reclaimed late - lookups therefore treat any entry older than the maximum age as absent.
+//
+// Value must have a "std::chrono::steady_clock::time_point time" member which is used for aging.
+// Key must be comparable with operator== and hashable with Hash.
+//
+template <class Key, class Value, class Hash, size_t kMaxEntries> class AgingTable {
+public:
+    typedef std::chrono::steady_clock::time_point time_point;
+
+    explicit AgingTable(std::chrono::milliseconds max_age) : max_age_(max_age) {}
+
+    size_t size() const { return size_; }
+    bool full() const { return size_ >= kMaxEntries; }
+
+    // return the value matching key or nullptr if key is not in the table (or too old)
+    Value *find(const Key &key, time_point now)
+    {
+        size_t idx;
+        if (!lookup(key, idx) || expired(slots_[idx], now)) {
+            return nullptr;
+        }
+        return &slots_[idx].value;
+    }
+
+    // insert a default constructed value for key (or return the existing one)
+    // an existing entry which is too old is passed to on_expire(value) and replaced
+    // return nullptr if the table is full
+    template <class F> Value *insert(const Key &key, time_point now, F on_expire)
+    {
+        size_t idx;
+        if (lookup(key, idx)) {
+            Slot &slot = slots_[idx];
+            if (expired(slot, now)) {
+                on_expire(slot.value);
+                init_slot(slot, key, now);
+            }
+            return &slot.value;
+        }
+        if (full()) {
+            // entries which were refreshed may be too old but still wait in the ring
+            sweep(now, on_expire);
+            if (full()) {
+                return nullptr;
+            }
+            lookup(key, idx);
+        }
+
+        init_slot(slots_[idx], key, now);
+        size_++;
+        return &slots_[idx].value;
+    }
+
+    Value *insert(const Key &key, time_point now)
+    {
+        return insert(key, now, [](Value &value) {});
+    }
+
+    bool erase(const Key &key)
+    {
+        size_t idx;
+        if (!lookup(key, idx)) {
+            return false;
+        }
+        erase_slot(idx);
+        return true;
+    }
+
+    // remove all the entries older than the maximum age, on_expire(value) is called for each
+    template <class F> void expire(time_point now, F on_expire)
+    {
+        while (ring_count_ > 0) {
+            RingEntry &front = ring_[ring_head_];
+            if (now <= front.time + max_age_) {
+                break;
+            }
+            RingEntry entry = front;
+            ring_pop();
+
+            size_t idx;
+            if (!lookup(entry.key, idx) || slots_[idx].seq != entry.seq) {
+                continue; // stale - the entry was already erased
+            }
+            Slot &slot = slots_[idx];
+            if (expired(slot, now)) {
+                on_expire(slot.value);
+                erase_slot(idx);
+            } else {
+                // refreshed since it was pushed - age it again from its current time
+                ring_push(entry.key, entry.seq, slot.value.time);
+            }
+        }
+    }
+
+    void expire(time_point now) { expire(now, [](Value &value) {}); }
+
+private:
+    // slots are kept at most half full to keep the probe sequences short
+    static constexpr size_t kSlots = aging_table_next_pow2(2 * kMaxEntries);
+    static constexpr size_t kMask  = kSlots - 1;
+    // records of erased entries may still be in the ring, leave room for them
+    static constexpr size_t kRingSize = 2 * kMaxEntries;
+
+    struct Slot {
+        bool used    = false;
+        uint32_t seq = 0;
+        Key key;
+        Value value;
+    };
+
+    struct RingEntry {
+        Key key;
+        uint32_t seq;
+        time_point time;
+    };
+
+    bool expired(const Slot &slot, time_point now) const
+    {
+        return now > slot.value.time + max_age_;
+    }
+
+    void init_slot(Slot &slot, const Key &key, time_point now)
+    {
+        slot.used       = true;
+        slot.key        = key;
+        slot.seq        = ++seq_;
+        slot.value      = Value();
+        slot.value.time = now;
+        ring_push(key, slot.seq, now);
+    }
+
+    // remove all the entries older than the maximum age by scanning the whole table
+    template <class F> void sweep(time_point now, F on_expire)
+    {
+        size_t idx = 0;
+        while (idx < kSlots) {
+            if (slots_[idx].used && expired(slots_[idx], now)) {
+                on_expire(slots_[idx].value);
+                // the slot is refilled by the backward shift, check it again
+                erase_slot(idx);
+            } else {
+                idx++;
+            }
+        }
+    }
+
+    // return true if key was found, idx is set to the slot of the key or to the free slot
+    // where it should be inserted
+    bool lookup(const Key &key, size_t &idx) const
+    {
+        idx = Hash()(key) & kMask;
+        while (slots_[idx].used) {
+            if (slots_[idx].key == key) {
+                return true;
+            }
+            idx = (idx + 1) & kMask;
+        }
+        return false;
+    }
+
+    void erase_slot(size_t idx)
+    {
+        slots_[idx].used = false;
+        size_--;
+
+        // backward shift the following entries of the probe sequence into the freed slot
+        size_t next = idx;
+        while (true) {
+            next = (next + 1) & kMask;
+            if (!slots_[next].used) {
+                break;
+            }
+            size_t home = Hash()(slots_[next].key) & kMask;
+            bool in_place =
+                (idx <= next) ? (idx < home && home <= next) : (idx < home || home <= next);
+            if (in_place) {
+                continue;
+            }
+            slots_[idx]       = std::move(slots_[next]);
+            slots_[next].used = false;
+            idx               = next;
+        }
+    }
+
+    void ring_push(const Key &key, uint32_t seq, time_point time)
+    {
+        if (ring_count_ == kRingSize) {
+            ring_compact();
+        }
+        RingEntry &entry = ring_[(ring_head_ + ring_count_) % kRingSize];
+        entry.key        = key;
+        entry.seq        = seq;
+        entry.time       = time;
+        ring_count_++;
+    }
+
+    void ring_pop()
+    {
+        ring_head_ = (ring_head_ + 1) % kRingSize;
+        ring_count_--;
+    }
+
+    // drop the records of erased entries, at most kMaxEntries records are live so this frees
+    // at least half of the ring
+    void ring_compact()
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < ring_count_; i++) {
+            RingEntry &entry = ring_[(ring_head_ + i) % kRingSize];
+            size_t idx;
+            if (lookup(entry.key, idx) && slots_[idx].seq == entry.seq) {
+                ring_[(ring_head_ + count) % kRingSize] = entry;
+                count++;
+            }
+        }
+        ring_count_ = count;
+    }
+
+    const std::chrono::milliseconds max_age_;
+    std::array<Slot, kSlots> slots_;
+    size_t size_  = 0;
+    uint32_t seq_ = 0;
+    std::array<RingEntry, kRingSize> ring_;
+    size_t ring_head_  = 0;
+    size_t ring_count_ = 0;
+};
+
+}; // namespace mapf
+
+#endif // MAP_TRANSPORT_IEEE1905_TRANSPORT_AGING_TABLE_H_
@@ -67,13 +67,20 @@ public:
         mapf_assert(this->frames().size() <= 1);
 
         if (this->frames().empty()) {
-            Message::Frame frame(sizeof(Metadata));
-            Add(frame);
+            Add(Message::Frame(sizeof(Metadata)));
         } else if (this->frames().back().len() < sizeof(Metadata)) {
-            this->frames().back().set_size(sizeof(Metadata));
+            ResizeFrame(sizeof(Metadata));
         }
     }
 
+    // Allocate the frame for a payload of payload_len bytes up front, so filling in the payload
+    // through data() does not need to grow (reallocate and copy) the frame.
+    explicit CmduXxMessage(size_t payload_len)
+        : CmduXxMessage("", {Frame(sizeof(Metadata) + payload_len)})
+    {
+        metadata()->length = payload_len;
+    }
+
     virtual const std::string topic_prefix() const = 0;
 
     virtual const std::string topic() const
@@ -83,11 +90,11 @@ public:
 
     Metadata *metadata() const { return (Metadata *)frames().back().data(); };
 
-    uint8_t *data() const
+    uint8_t *data()
     {
         mapf_assert(!frames().empty());
 
-        frames().back().set_size(sizeof(Metadata) + metadata()->length);
+        ResizeFrame(sizeof(Metadata) + metadata()->length);
         return frames().back().data() + sizeof(Metadata);
     };
 
@@ -192,10 +199,9 @@ public:
         mapf_assert(this->frames().size() <= 1);
 
         if (this->frames().empty()) {
-            Message::Frame frame(sizeof(Metadata));
-            Add(frame);
+            Add(Message::Frame(sizeof(Metadata)));
         } else if (this->frames().back().len() < sizeof(Metadata)) {
-            this->frames().back().set_size(sizeof(Metadata));
+            ResizeFrame(sizeof(Metadata));
         }
     }
 
@@ -267,6 +273,7 @@ public:
     enum Flags {
         ENABLE_IEEE1905_TRANSPORT = 0x00000001, // enable IEEE1905 transport on this interface
         IS_BRIDGE                 = 0x00000002,
+        ENABLE_RX_RING            = 0x00000004, // receive through a memory mapped ring (TPACKET_V3)
     };
 
     struct Interface {
@@ -297,10 +304,9 @@ public:
         mapf_assert(this->frames().size() <= 1);
 
         if (this->frames().empty()) {
-            Message::Frame frame(sizeof(Metadata));
-            Add(frame);
+            Add(Message::Frame(sizeof(Metadata)));
         } else if (this->frames().back().len() < sizeof(Metadata)) {
-            this->frames().back().set_size(sizeof(Metadata));
+            ResizeFrame(sizeof(Metadata));
         }
     }
 
@@ -325,7 +331,8 @@ public:
                << " if_index: " << m->interfaces[i].if_index
                << " in bridge: " << m->interfaces[i].bridge_if_index << " flags:"
                << ((m->interfaces[i].flags & Flags::ENABLE_IEEE1905_TRANSPORT) ? " transport" : "")
-               << ((m->interfaces[i].flags & Flags::IS_BRIDGE) ? " bridge" : "") << std::endl;
+               << ((m->interfaces[i].flags & Flags::IS_BRIDGE) ? " bridge" : "")
+               << ((m->interfaces[i].flags & Flags::ENABLE_RX_RING) ? " rx_ring" : "") << std::endl;
         }
 
         return os << ss.str();
@@ -143,6 +143,7 @@ static unsigned int ieee1905_bridge_if_index     = 0;
 static unsigned int ieee1905_if_indexes[MAX_IFS] = {0};
 static bool only_configure_interfaces            = false;
 static bool use_unicast_address                  = false;
+static bool use_rx_ring                          = false;
 static uint8_t unicast_address[6];
 using namespace mapf;
 
@@ -250,7 +251,7 @@ int main(int argc, char *argv[])
 
     int c;
     int interfaces = 0;
-    while ((c = getopt(argc, argv, "b:i:u:x")) != -1) {
+    while ((c = getopt(argc, argv, "b:i:ru:x")) != -1) {
         switch (c) {
         case 'b':
             ieee1905_bridge_if_index = if_nametoindex(optarg);
@@ -267,6 +268,9 @@ int main(int argc, char *argv[])
             }
             interfaces++;
             break;
+        case 'r':
+            use_rx_ring = true;
+            break;
         case 'x':
             only_configure_interfaces = true;
             break;
@@ -289,7 +293,8 @@ int main(int argc, char *argv[])
             }
         // intentional fallthrough
         default:
-            fprintf(stderr, "usage: %s [-b <interface name>] [-i <interface name>] [-x]...\n",
+            fprintf(stderr,
+                    "usage: %s [-b <interface name>] [-i <interface name>] [-r] [-x]...\n",
                     argv[0]);
             return false;
         }
@@ -409,6 +414,10 @@ int main(int argc, char *argv[])
                     ieee1905_if_indexes[i];
                 interface_configuration_request_msg.metadata()->interfaces[n].flags |=
                     Flags::ENABLE_IEEE1905_TRANSPORT;
+                if (use_rx_ring) {
+                    interface_configuration_request_msg.metadata()->interfaces[n].flags |=
+                        Flags::ENABLE_RX_RING;
+                }
                 n++;
             }
         }